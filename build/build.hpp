@@ -0,0 +1,6 @@
+#define VERSION "2.1.0"
+#define IDENTIFIER "be4d3a112bcffa3ca06365a85671a4a3bd8da4f1"
+#define SHORTID "be4d3a1"
+#define COMPILER "g++ (Debian 12.2.0-14+deb12u1) 12.2.0"
+#define FLAGS "-Wall -Wextra -O3 -DNDEBUG"
+#define DATE "Sat Oct 17 06:49:53 UTC 2026 Linux vm 6.18.44-fc-v130 x86_64"
@@ -0,0 +1,17 @@
+#include <atomic>
+#include <mutex>
+#include <thread>
+static std::atomic<int> counter (0);
+static std::mutex lock;
+static int shared = 0;
+static void work () {
+  counter++;
+  std::lock_guard<std::mutex> guard (lock);
+  shared++;
+}
+int main () {
+  std::thread thread (work);
+  work ();
+  thread.join ();
+  return !(counter == 2 && shared == 2);
+}
@@ -1,7 +1,13 @@
 #!/bin/sh
 usage () {
 cat <<EOF 2>&1
-usage: generate-cubes.sh [-h] <input> [ <output> [ <march_cu option> ... ] ]
+usage: generate-cubes.sh [-h] <input> [ <output> [ <cadical option> ... ] ]
+
+Writes the simplified formula of '<input>' followed by cubes generated by
+lookahead in 'cadical' as incremental 'p inccnf' file to '<output>' (or
+'<stdout>').  The depth of cubes is set with '--cube-depth=<depth>'.
+The 'cadical' binary is taken from the 'CADICAL' environment variable or
+searched in the 'PATH'.
 EOF
 exit 0
 }
@@ -11,7 +17,6 @@ die () {
   exit 1
 }
 [ $# -lt 1 ] && die "expected DIMACS file argument"
-output=""
 options=""
 [ -f "$1" ] || die "first argument is not a DIMACS file"
 input="$1"
@@ -24,14 +29,5 @@ do
   esac
   shift
 done
-prefix=/tmp/generate-cubes-$$
-cleanup () {
-  rm -f $prefix*
-}
-trap "cleanup" 2 11
-cubes=$prefix.cubes
-march_cu $input -o $cubes $options 1>&2 || exit 1
-sed -e 's,^p cnf.*,p inccnf,' $input
-cat $cubes
-cleanup
-exit 0
+cadical=${CADICAL:-cadical}
+exec $cadical -q -f --write-inccnf=/dev/stdout $options $input
@@ -788,7 +788,7 @@ Clause *Internal::on_the_fly_strengthen (Clause *new_conflict, int uip) {
   if (other_init != other)
     watch_literal (other, lits[1], new_conflict);
   else {
-    update_watch_size (watches (other), lits[1], new_conflict);
+    update_watch_size (watches (other), other, lits[1], new_conflict);
   }
   watch_literal (lits[1], other, new_conflict);
 
@@ -940,6 +940,8 @@ void Internal::analyze () {
     learn_empty_clause ();
     if (external->learner)
       external->export_learned_empty_clause ();
+    if (!external->export_buffers.empty ())
+      external->export_shared_clause (clause, 0);
     // lrat_chain.clear (); done in learn_empty_clause
     STOP (analyze);
     return;
@@ -1103,6 +1105,9 @@ void Internal::analyze () {
   } else if (external->learner)
     external->export_learned_unit_clause (-uip);
 
+  if (!external->export_buffers.empty ())
+    external->export_shared_clause (clause, glue);
+
   // Update actual size statistics.
   //
   stats.units += (size == 1);
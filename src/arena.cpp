@@ -1,5 +1,12 @@
 #include "internal.hpp"
 
+#ifdef COMPACT
+#include <map>
+#include <mutex>
+#include <set>
+#include <sys/mman.h>
+#endif
+
 namespace CaDiCaL {
 
 Arena::Arena (Internal *i) {
@@ -8,23 +15,144 @@ Arena::Arena (Internal *i) {
 }
 
 Arena::~Arena () {
+#ifdef COMPACT
+  if (from.start)
+    ClauseSpace::deallocate (from.start, from.end - from.start);
+  if (to.start)
+    ClauseSpace::deallocate (to.start, to.end - to.start);
+#else
   delete[] from.start;
   delete[] to.start;
+#endif
 }
 
 void Arena::prepare (size_t bytes) {
   LOG ("preparing 'to' space of arena with %zd bytes", bytes);
   assert (!to.start);
+#ifdef COMPACT
+  to.top = to.start = ClauseSpace::allocate (bytes);
+#else
   to.top = to.start = new char[bytes];
+#endif
   to.end = to.start + bytes;
 }
 
 void Arena::swap () {
+#ifdef COMPACT
+  if (from.start)
+    ClauseSpace::deallocate (from.start, from.end - from.start);
+#else
   delete[] from.start;
+#endif
   LOG ("delete 'from' space of arena with %zd bytes",
        (size_t) (from.end - from.start));
   from = to;
   to.start = to.top = to.end = 0;
 }
 
+/*------------------------------------------------------------------------*/
+
+#ifdef COMPACT
+
+char *ClauseSpace::base;
+
+// The state of the allocator is only accessed while holding the lock.
+// Offsets and sizes of blocks are in units.  It is allocated on first use
+// and never deleted, since solvers might still be deleted during the
+// destruction of static objects (in arbitrary order) at exit.
+
+struct ClauseSpaceState {
+  std::mutex lock;
+  size_t top = 0;
+  std::map<size_t, size_t> free_by_offset;
+  std::set<std::pair<size_t, size_t>> free_by_size;
+};
+
+static ClauseSpaceState &clause_space_state () {
+  static ClauseSpaceState *state = new ClauseSpaceState ();
+  return *state;
+}
+
+static void reserve_clause_space (char *&base) {
+  void *p = mmap (0, ClauseSpace::max_bytes, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (p == MAP_FAILED)
+    fatal ("failed to reserve %zu bytes of virtual memory for clauses",
+           ClauseSpace::max_bytes);
+  base = (char *) p;
+}
+
+static void remove_free_block (ClauseSpaceState &state, size_t offset,
+                               size_t units) {
+  state.free_by_offset.erase (offset);
+  state.free_by_size.erase (std::make_pair (units, offset));
+}
+
+static void add_free_block (ClauseSpaceState &state, size_t offset,
+                            size_t units) {
+  state.free_by_offset[offset] = units;
+  state.free_by_size.insert (std::make_pair (units, offset));
+}
+
+static size_t clause_space_units (size_t bytes) {
+  const size_t unit = ClauseSpace::unit;
+  return std::max ((size_t) 1, (bytes + unit - 1) / unit);
+}
+
+char *ClauseSpace::allocate (size_t bytes) {
+  const size_t units = clause_space_units (bytes);
+  ClauseSpaceState &state = clause_space_state ();
+  std::lock_guard<std::mutex> guard (state.lock);
+  if (!base)
+    reserve_clause_space (base);
+  size_t offset;
+  auto best = state.free_by_size.lower_bound (std::make_pair (units, 0));
+  if (best != state.free_by_size.end ()) {
+    const size_t best_units = best->first;
+    offset = best->second;
+    remove_free_block (state, offset, best_units);
+    if (best_units > units)
+      add_free_block (state, offset + units, best_units - units);
+  } else {
+    if (max_units - state.top < units)
+      fatal ("clause memory limit of %zu bytes of compact configuration "
+             "exceeded",
+             max_bytes);
+    offset = state.top;
+    state.top += units;
+  }
+  return base + offset * unit;
+}
+
+void ClauseSpace::deallocate (char *p, size_t bytes) {
+  size_t units = clause_space_units (bytes);
+  ClauseSpaceState &state = clause_space_state ();
+  std::lock_guard<std::mutex> guard (state.lock);
+  assert (base <= p), assert (!((p - base) % unit));
+  size_t offset = (p - base) / unit;
+  assert (offset + units <= state.top);
+  auto next = state.free_by_offset.lower_bound (offset);
+  if (next != state.free_by_offset.end () &&
+      offset + units == next->first) {
+    const size_t next_units = next->second;
+    remove_free_block (state, next->first, next_units);
+    units += next_units;
+  }
+  next = state.free_by_offset.lower_bound (offset);
+  if (next != state.free_by_offset.begin ()) {
+    auto prev = std::prev (next);
+    if (prev->first + prev->second == offset) {
+      const size_t prev_offset = prev->first, prev_units = prev->second;
+      remove_free_block (state, prev_offset, prev_units);
+      offset = prev_offset, units += prev_units;
+    }
+  }
+  if (offset + units == state.top)
+    state.top = offset;
+  else
+    add_free_block (state, offset, units);
+}
+
+#endif
+
 } // namespace CaDiCaL
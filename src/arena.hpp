@@ -99,6 +99,52 @@ public:
   void swap ();
 };
 
+#ifdef COMPACT
+
+// With 'COMPACT' (configured with './configure --compact') watches refer
+// to clauses through 32-bit references instead of 64-bit pointers, which
+// halves the size of watches (see 'watch.hpp').  To make this possible all
+// clauses, that is the 'from' and 'to' space of the arena as well as the
+// clauses allocated outside of the arena, are allocated in one contiguous
+// region of virtual memory.  It is reserved once for the whole process and
+// thus shared by all solvers (which might run in different threads).
+//
+// References are offsets into this region in units of the eight byte
+// alignment of clauses.  Since watches use one bit of the reference to
+// denote binary clauses, 31 bits remain, which limits the memory for
+// clauses to 16 GB ('max_bytes').  With at least 32 bytes per clause this
+// is room for at most 2^29 (about 537 million) clauses.  The solver aborts
+// with a fatal error if this limit is exceeded.
+//
+// Freed memory is kept in free lists ordered by size (best fit) and by
+// offset (to merge adjacent free blocks).  Clauses shrunken outside of the
+// arena give back their unused tail (see 'shrink_clause').
+
+class ClauseSpace {
+
+  static char *base; // Start of reserved region.
+
+public:
+  static const size_t unit = 8;
+  static const size_t max_units = (size_t) 1 << 31;
+  static const size_t max_bytes = max_units * unit;
+
+  static char *allocate (size_t bytes);
+  static void deallocate (char *, size_t bytes);
+
+  static unsigned reference (const void *p) {
+    assert (base <= (const char *) p);
+    const size_t offset = (const char *) p - base;
+    assert (!(offset % unit));
+    assert (offset / unit < max_units);
+    return offset / unit;
+  }
+
+  static void *dereference (unsigned ref) { return base + ref * unit; }
+};
+
+#endif
+
 } // namespace CaDiCaL
 
 #endif
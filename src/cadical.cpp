@@ -3,7 +3,9 @@
 // Do include 'internal.hpp' but try to minimize internal dependencies.
 
 #include "internal.hpp"
-#include "signal.hpp" // Separate, only need for apps.
+#include "conquer.hpp"   // Separate, only need for apps.
+#include "portfolio.hpp" // Separate, only need for apps.
+#include "signal.hpp"    // Separate, only need for apps.
 
 /*------------------------------------------------------------------------*/
 
@@ -21,9 +23,11 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
-class App : public Handler, public Terminator {
+class App : public Handler, public Terminator, public ConquerHandler {
 
-  Solver *solver; // Global solver.
+  Solver *solver;       // Global solver.
+  Conquer *conquer;     // Parallel cube solving (if used).
+  Portfolio *portfolio; // Parallel portfolio solving (if used).
 
 #ifndef __WIN32
   // Command line options.
@@ -45,6 +49,25 @@ class App : public Handler, public Terminator {
   bool force_writing;
   static bool most_likely_existing_cnf_file (const char *path);
 
+  // Cube and conquer:
+  //
+  int cube_depth; // '--cube-and-conquer=<depth>'
+  int threads;    // '--threads=<num>'
+  int share;      // '--share=<size>'
+  int resplit;    // '--resplit=<depth>'
+
+  // Portfolio of differently configured solvers:
+  //
+  int portfolio_threads;               // '--portfolio=<num>'
+  vector<const char *> worker_options; // Also set for every worker.
+
+  // Writing cubes instead of solving:
+  //
+  const char *cubes_path; // '--write-cubes=<path>' or '--write-inccnf=...'
+  bool cubes_inccnf;      // Prefix cubes with formula ('--write-inccnf').
+  int cubes_depth;        // '--cube-depth=<depth>'
+  int shards;             // '--shards=<num>'
+
   // Internal variables.
   //
   int max_var;           // Set after parsing.
@@ -55,6 +78,36 @@ class App : public Handler, public Terminator {
   void print_usage (bool all = false);
   void print_witness (FILE *);
 
+  // Generate cubes and solve them in parallel.
+  //
+  int cube_and_conquer (int conflict_limit, int decision_limit);
+
+  // Solving cubes (incrementally or in parallel) and their statistics.
+  //
+  int conquer_cubes (const vector<vector<int>> &, int conflict_limit,
+                     int decision_limit);
+  void conquer_summary (const char *);
+  struct {
+    size_t cubes, solved, satisfiable, unsatisfiable, inconclusive;
+    size_t resplit; // Inconclusive cubes split again.
+    bool reporting; // Cube messages are interleaved with reports.
+    double time;    // Sum of times spent on solving cubes.
+  } conquered_cubes;
+
+  // Splitting inconclusive cubes again ('--resplit=<depth>').
+  //
+  vector<size_t> inconclusive_cubes; // Reported by 'conquered'.
+  size_t conquered_offset;           // First cube of parallel round.
+  int resplit_cube (const vector<int> &, vector<vector<int>> &);
+
+  // Solve with a portfolio of solvers in parallel.
+  //
+  int solve_portfolio (int conflict_limit);
+
+  // Writing cubes distributed over several files.
+  //
+  const char *write_shards ();
+
 #ifndef QUIET
   void signal_message (const char *msg, int sig);
 #endif
@@ -81,6 +134,10 @@ class App : public Handler, public Terminator {
   void catch_signal (int sig);
   void catch_alarm ();
 
+  // Conquer handler interface.
+  //
+  void conquered (size_t cube, int res, double seconds);
+
 public:
   App ();
   ~App ();
@@ -166,7 +223,36 @@ void App::print_usage (bool all) {
         "  --no-witness   do not print witness (see also '-n' above)\n"
         "\n"
         "  --build        print build configuration\n"
-        "  --copyright    print copyright information\n");
+        "  --copyright    print copyright information\n"
+        "\n"
+        "  --cube-and-conquer=<depth>\n"
+        "                 generate cubes of the given depth by lookahead\n"
+        "                 and solve them in parallel on copies of the\n"
+        "                 simplified formula\n"
+        "  --threads=<num>\n"
+        "                 number of threads solving cubes (default '1')\n"
+        "  --share=<size>\n"
+        "                 maximum size of learned clauses shared between\n"
+        "                 threads solving cubes (default '4')\n"
+        "  --resplit=<depth>\n"
+        "                 split cubes which hit the conflict or decision\n"
+        "                 limit again into cubes of the given depth\n"
+        "\n"
+        "  --portfolio=<num>\n"
+        "                 solve with that many differently configured\n"
+        "                 copies of the solver in parallel threads\n"
+        "\n"
+        "  --write-cubes=<path>\n"
+        "                 write cubes generated by lookahead in 'march_cu'\n"
+        "                 format ('a <lit> ... 0' lines) instead of solving\n"
+        "  --write-inccnf=<path>\n"
+        "                 write simplified formula followed by cubes as\n"
+        "                 incremental 'p inccnf' file instead of solving\n"
+        "  --cube-depth=<depth>\n"
+        "                 maximum depth of written cubes (default '10')\n"
+        "  --shards=<num>\n"
+        "                 distribute written cubes over that many files of\n"
+        "                 similar estimated difficulty (default '1')\n");
 
     printf ("\n"
             "There are pre-defined configurations of advanced internal "
@@ -236,6 +322,19 @@ void App::print_usage (bool all) {
         "prints the standard unsatisfiable solution line ('s "
         "UNSATISFIABLE').\n"
         "\n"
+        "With '--threads=<num>' larger than one the cubes are distributed\n"
+        "dynamically over copies of the solver running in parallel.\n"
+        "With '--resplit=<depth>' cubes which hit the limits are split\n"
+        "again by lookahead on the global solver and the resulting cubes\n"
+        "are solved too (after the current ones in parallel mode).\n"
+        "\n"
+        "Cubes written with '--write-cubes' or '--write-inccnf' are streamed\n"
+        "to the file while they are generated.  The cubing options (for\n"
+        "instance '--cubetarget', '--cubemax' or '--cubetime') apply.\n"
+        "With '--shards=<num>' cubes are written to '<num>' files instead\n"
+        "with the shard index inserted before the first extension of the\n"
+        "path, e.g., 'cubes-0.icnf.gz', 'cubes-1.icnf.gz', etc.\n"
+        "\n"
         "By default the proof is stored in the binary DRAT format unless\n"
         "the option '--no-binary' is specified or the proof is written\n"
         "to  '<stdout>' and '<stdout>' is connected to a terminal.\n"
@@ -266,6 +365,10 @@ void App::print_witness (FILE *file) {
       fputc ('v', file), c = 1;
     if (i++ == max_var)
       tmp = 0;
+    else if (conquer && conquer->status () == 10)
+      tmp = conquer->val (i) < 0 ? -i : i;
+    else if (portfolio && portfolio->status () == 10)
+      tmp = portfolio->val (i) < 0 ? -i : i;
     else
       tmp = solver->val (i) < 0 ? -i : i;
     char str[32];
@@ -375,6 +478,10 @@ int App::main (int argc, char **argv) {
   const char *conflict_limit_specified = 0;
   const char *decision_limit_specified = 0;
   const char *localsearch_specified = 0;
+  const char *cube_depth_specified = 0, *threads_specified = 0;
+  const char *share_specified = 0, *cubes_depth_specified = 0;
+  const char *shards_specified = 0, *resplit_specified = 0;
+  const char *portfolio_specified = 0;
 #ifndef __MINGW32__
   const char *time_limit_specified = 0;
 #endif
@@ -522,7 +629,92 @@ int App::main (int argc, char **argv) {
              !strcmp (argv[i], "--strict=1") ||
              !strcmp (argv[i], "--strict=true"))
       force_strict_parsing = 2;
-    else if (has_prefix (argv[i], "-O")) {
+    else if (has_prefix (argv[i], "--cube-and-conquer=")) {
+      if (cube_depth_specified)
+        APPERR ("multiple cube and conquer options '%s' and '%s'",
+                cube_depth_specified, argv[i]);
+      cube_depth_specified = argv[i];
+      if (!parse_int_str (argv[i] + 19, cube_depth))
+        APPERR ("invalid cube and conquer option '%s'", argv[i]);
+      if (cube_depth < 0)
+        APPERR ("invalid argument in '%s' (expected non-negative depth)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--threads=")) {
+      if (threads_specified)
+        APPERR ("multiple thread options '%s' and '%s'", threads_specified,
+                argv[i]);
+      threads_specified = argv[i];
+      if (!parse_int_str (argv[i] + 10, threads))
+        APPERR ("invalid thread option '%s'", argv[i]);
+      if (threads < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--share=")) {
+      if (share_specified)
+        APPERR ("multiple share options '%s' and '%s'", share_specified,
+                argv[i]);
+      share_specified = argv[i];
+      if (!parse_int_str (argv[i] + 8, share))
+        APPERR ("invalid share option '%s'", argv[i]);
+      if (share < 0)
+        APPERR ("invalid argument in '%s' (expected non-negative size)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--resplit=")) {
+      if (resplit_specified)
+        APPERR ("multiple resplit options '%s' and '%s'", resplit_specified,
+                argv[i]);
+      resplit_specified = argv[i];
+      if (!parse_int_str (argv[i] + 10, resplit))
+        APPERR ("invalid resplit option '%s'", argv[i]);
+      if (resplit < 1)
+        APPERR ("invalid argument in '%s' (expected positive depth)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--portfolio=")) {
+      if (portfolio_specified)
+        APPERR ("multiple portfolio options '%s' and '%s'",
+                portfolio_specified, argv[i]);
+      portfolio_specified = argv[i];
+      if (!parse_int_str (argv[i] + 12, portfolio_threads))
+        APPERR ("invalid portfolio option '%s'", argv[i]);
+      if (portfolio_threads < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--write-cubes=") ||
+               has_prefix (argv[i], "--write-inccnf=")) {
+      const bool inccnf = has_prefix (argv[i], "--write-inccnf=");
+      const char *path = argv[i] + (inccnf ? 15 : 14);
+      if (cubes_path)
+        APPERR ("multiple cube file options '%s' and '%s'", cubes_path,
+                argv[i]);
+      else if (!*path)
+        APPERR ("argument to '%s' missing", argv[i]);
+      else if (!force_writing && most_likely_existing_cnf_file (path))
+        APPERR ("cube file '%s' most likely existing CNF (use '-f')", path);
+      else if (!File::writable (path))
+        APPERR ("cube file '%s' not writable", path);
+      cubes_path = path;
+      cubes_inccnf = inccnf;
+    } else if (has_prefix (argv[i], "--cube-depth=")) {
+      if (cubes_depth_specified)
+        APPERR ("multiple cube depth options '%s' and '%s'",
+                cubes_depth_specified, argv[i]);
+      cubes_depth_specified = argv[i];
+      if (!parse_int_str (argv[i] + 13, cubes_depth))
+        APPERR ("invalid cube depth option '%s'", argv[i]);
+      if (cubes_depth < 0)
+        APPERR ("invalid argument in '%s' (expected non-negative depth)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "--shards=")) {
+      if (shards_specified)
+        APPERR ("multiple shard options '%s' and '%s'", shards_specified,
+                argv[i]);
+      shards_specified = argv[i];
+      if (!parse_int_str (argv[i] + 9, shards))
+        APPERR ("invalid shard option '%s'", argv[i]);
+      if (shards < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+                argv[i]);
+    } else if (has_prefix (argv[i], "-O")) {
       if (optimization_specified)
         APPERR ("multiple optimization options '%s' and '%s'",
                 optimization_specified, argv[i]);
@@ -554,8 +746,9 @@ int App::main (int argc, char **argv) {
     } else if (has_prefix (argv[i], "--") &&
                solver->is_valid_configuration (argv[i] + 2)) {
       solver->configure (argv[i] + 2);
+      worker_options.push_back (argv[i]);
     } else if (set (argv[i])) {
-      /* nothing do be done */
+      worker_options.push_back (argv[i]);
     } else if (argv[i][0] == '-')
       APPERR ("invalid option '%s'", argv[i]);
     else if (proof_specified)
@@ -582,6 +775,30 @@ int App::main (int argc, char **argv) {
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
     APPERR ("DIMACS input file '%s' also specified as DRAT proof file",
             dimacs_path);
+  if (cube_depth_specified && proof_specified)
+    APPERR ("can not combine '%s' with proof tracing",
+            cube_depth_specified);
+  if (threads > 1 && proof_specified)
+    APPERR ("can not combine '%s' with proof tracing", threads_specified);
+  if (portfolio_specified && proof_specified)
+    APPERR ("can not combine '%s' with proof tracing", portfolio_specified);
+  if (portfolio_specified && (cube_depth_specified || threads_specified))
+    APPERR ("can not combine '%s' with '%s'", portfolio_specified,
+            cube_depth_specified ? cube_depth_specified : threads_specified);
+  if (portfolio_specified && cubes_path)
+    APPERR ("can not combine '%s' with writing cubes", portfolio_specified);
+  if (portfolio_specified && decision_limit_specified)
+    APPERR ("can not combine '%s' with '%s'", portfolio_specified,
+            decision_limit_specified);
+  if (cubes_path && cube_depth_specified)
+    APPERR ("can not combine '%s' with writing cubes",
+            cube_depth_specified);
+  if (cubes_depth_specified && !cubes_path)
+    APPERR ("'%s' requires '--write-cubes' or '--write-inccnf'",
+            cubes_depth_specified);
+  if (shards_specified && !cubes_path)
+    APPERR ("'%s' requires '--write-cubes' or '--write-inccnf'",
+            shards_specified);
 
   /*----------------------------------------------------------------------*/
   // The '--less' option is not fully functional yet (it is also not
@@ -704,6 +921,17 @@ int App::main (int argc, char **argv) {
                                cube_literals);
   if (err)
     APPERR ("%s", err);
+  if (incremental && cube_depth_specified)
+    APPERR ("can not use '%s' with incremental 'p inccnf' input",
+            cube_depth_specified);
+  if (incremental && cubes_path)
+    APPERR ("can not write cubes for incremental 'p inccnf' input");
+  if (incremental && portfolio_specified)
+    APPERR ("can not use '%s' with incremental 'p inccnf' input",
+            portfolio_specified);
+  if (resplit_specified && !incremental && !cube_depth_specified)
+    APPERR ("'%s' requires cubes ('p inccnf' input or cube and conquer)",
+            resplit_specified);
   if (read_solution_path) {
     solver->section ("parsing solution");
     solver->message ("reading solution file from '%s'", read_solution_path);
@@ -726,13 +954,12 @@ int App::main (int argc, char **argv) {
       set ("report", 0);
     if (!reporting)
       solver->section ("incremental solving");
-    size_t cubes = 0, solved = 0;
-    size_t satisfiable = 0, unsatisfiable = 0, inconclusive = 0;
+    memset (&conquered_cubes, 0, sizeof conquered_cubes);
+    conquered_cubes.reporting = reporting;
+    size_t &cubes = conquered_cubes.cubes;
 #ifndef QUIET
     bool quiet = get ("quiet");
-    struct {
-      double start, delta, sum;
-    } time = {0, 0, 0};
+    double start = 0;
 #endif
     for (auto lit : cube_literals)
       if (!lit)
@@ -744,12 +971,23 @@ int App::main (int argc, char **argv) {
       else
         solver->message ("no cube to solve");
     }
+    vector<vector<int>> all;
     vector<int> cube, failed;
     for (auto lit : cube_literals) {
       if (lit)
         cube.push_back (lit);
       else {
         reverse (cube.begin (), cube.end ());
+        all.push_back (cube);
+        cube.clear ();
+      }
+    }
+    if (threads > 1)
+      res = conquer_cubes (all, conflict_limit, decision_limit);
+    else {
+      size_t solved = 0;
+      for (size_t i = 0; i < all.size (); i++) {
+        cube = all[i]; // Copy since 'resplit_cube' extends 'all'.
         for (auto other : cube)
           solver->assume (other);
         if (solved++) {
@@ -759,91 +997,69 @@ int App::main (int argc, char **argv) {
             (void) solver->limit ("decisions", decision_limit);
         }
 #ifndef QUIET
-        char buffer[256];
         if (!quiet) {
           if (reporting) {
+            char buffer[256];
             snprintf (buffer, sizeof buffer,
                       "solving cube %zu / %zu %.0f%%", solved, cubes,
                       percent (solved, cubes));
             solver->section (buffer);
           }
-          time.start = absolute_process_time ();
+          start = absolute_process_time ();
         }
 #endif
         res = solver->solve ();
+        double delta = 0;
 #ifndef QUIET
-        if (!quiet) {
-          time.delta = absolute_process_time () - time.start;
-          time.sum += time.delta;
-          snprintf (buffer, sizeof buffer,
-                    "%s"
-                    "in %.3f sec "
-                    "(%.0f%% after %.2f sec at %.0f ms/cube)"
-                    "%s",
-                    tout.magenta_code (), time.delta,
-                    percent (solved, cubes), time.sum,
-                    relative (1e3 * time.sum, solved), tout.normal_code ());
-          if (reporting)
-            solver->message ();
-          const char *cube_str, *status_str, *color_code;
-          if (res == 10) {
-            cube_str = "CUBE";
-            color_code = tout.green_code ();
-            status_str = "SATISFIABLE";
-          } else if (res == 20) {
-            cube_str = "CUBE";
-            color_code = tout.cyan_code ();
-            status_str = "UNSATISFIABLE";
-          } else {
-            cube_str = "cube";
-            color_code = tout.magenta_code ();
-            status_str = "inconclusive";
-          }
-          const char *fmt;
-          if (reporting)
-            fmt = "%s%s %zu %s%s %s";
-          else
-            fmt = "%s%s %zu %-13s%s %s";
-          solver->message (fmt, color_code, cube_str, solved, status_str,
-                           tout.normal_code (), buffer);
-        }
+        if (!quiet)
+          delta = absolute_process_time () - start;
 #endif
+        if (res == 20) {
+          for (auto other : cube)
+            if (solver->failed (other))
+              failed.push_back (other);
+        }
+        conquered (solved - 1, res, delta);
         if (res == 10) {
-          satisfiable++;
           solver->conclude ();
           break;
         } else if (res == 20) {
-          unsatisfiable++;
           solver->conclude ();
-          for (auto other : cube)
-            if (solver->failed (other))
-              failed.push_back (other);
           for (auto other : failed)
             solver->add (-other);
           solver->add (0);
           failed.clear ();
         } else {
           assert (!res);
-          inconclusive++;
           if (timesup)
             break;
+          if (!inconclusive_cubes.empty ()) {
+            inconclusive_cubes.clear ();
+            if ((res = resplit_cube (cube, all)) == 10)
+              break;
+          }
         }
-        cube.clear ();
       }
+      if (conquered_cubes.inconclusive && res == 20)
+        res = 0;
     }
-    solver->section ("incremental summary");
-    solver->message ("%zu cubes solved %.0f%%", solved,
-                     percent (solved, cubes));
-    solver->message ("%zu cubes inconclusive %.0f%%", inconclusive,
-                     percent (inconclusive, solved));
-    solver->message ("%zu cubes unsatisfiable %.0f%%", unsatisfiable,
-                     percent (unsatisfiable, solved));
-    solver->message ("%zu cubes satisfiable %.0f%%", satisfiable,
-                     percent (satisfiable, solved));
-
-    if (inconclusive && res == 20)
-      res = 0;
-  } else {
+    conquer_summary ("incremental summary");
+  } else if (cube_depth_specified)
+    res = cube_and_conquer (conflict_limit, decision_limit);
+  else if (cubes_path) {
+    solver->section ("writing cubes");
+    solver->message ("writing cubes of depth %d to %s'%s'%s", cubes_depth,
+                     tout.green_code (), cubes_path, tout.normal_code ());
+    if (shards > 1)
+      err = write_shards ();
+    else
+      err = solver->write_cubes (cubes_path, cubes_depth, cubes_inccnf);
+    if (err)
+      APPERR ("%s", err);
+    status = false; // Cubes might be written to '<stdout>'.
+  } else if (portfolio_specified)
+    res = solve_portfolio (conflict_limit);
+  else {
     solver->section ("solving");
     res = solver->solve ();
   }
@@ -913,6 +1129,281 @@ int App::main (int argc, char **argv) {
 
 /*------------------------------------------------------------------------*/
 
+// Generate cubes on the global solver and then solve them in parallel on
+// copies of the simplified formula.  Conflict and decision limits apply
+// to each individual cube.
+
+int App::cube_and_conquer (int conflict_limit, int decision_limit) {
+  solver->section ("cube and conquer");
+  solver->message ("generating cubes of depth %d", cube_depth);
+  double start = absolute_real_time ();
+  auto cubes = solver->generate_cubes (cube_depth);
+  if (cubes.status) {
+    solver->message ("solved while generating cubes");
+    return solver->solve ();
+  }
+  solver->message ("generated %zu cubes in %.2f sec", cubes.cubes.size (),
+                   absolute_real_time () - start);
+  if (cubes.cubes.empty ()) {
+    solver->message ("all cubes refuted while generating cubes");
+    return 20;
+  }
+  memset (&conquered_cubes, 0, sizeof conquered_cubes);
+  conquered_cubes.cubes = cubes.cubes.size ();
+  int res = conquer_cubes (cubes.cubes, conflict_limit, decision_limit);
+  conquer_summary ("conquer summary");
+  return res;
+}
+
+// Solve the given cubes on copies of the solver in parallel.  With
+// '--resplit' this is repeated in rounds, where cubes which were
+// inconclusive in the previous round are split again on the global solver.
+
+int App::conquer_cubes (const vector<vector<int>> &cubes,
+                        int conflict_limit, int decision_limit) {
+  const vector<vector<int>> *current = &cubes;
+  vector<vector<int>> next;
+  int res;
+  for (;;) {
+    solver->message ("solving %zu cubes with %d threads", current->size (),
+                     threads);
+    delete conquer;
+    conquer = new Conquer (solver, threads, this, this);
+    conquer->limit (conflict_limit, decision_limit);
+    conquer->share (share);
+    conquered_offset = conquered_cubes.cubes - current->size ();
+    inconclusive_cubes.clear ();
+    res = conquer->solve (*current);
+    conquered_offset = 0;
+    if (res || !resplit || timesup || inconclusive_cubes.empty ())
+      break;
+    const vector<size_t> inconclusive = std::move (inconclusive_cubes);
+    vector<vector<int>> split;
+    for (auto i : inconclusive)
+      if ((res = resplit_cube ((*current)[i], split)) == 10 || timesup)
+        break;
+    if (res == 10 || timesup || split.empty ())
+      break;
+    next = std::move (split);
+    current = &next;
+  }
+  if (res == 20 && conquered_cubes.inconclusive)
+    res = 0;
+  return res;
+}
+
+// Split an inconclusive cube again by generating cubes of depth 'resplit'
+// under its literals as assumptions on the global solver and append the
+// sub-cubes to 'cubes'.  Returns '20' if the cube turned out to be
+// unsatisfiable while splitting and '10' if it turned out satisfiable (it
+// is then solved again on the global solver without limits to obtain a
+// model).  If a sub-cube does not extend the cube by a new literal, e.g.,
+// due to the cube budgets, it remains inconclusive.
+
+int App::resplit_cube (const vector<int> &cube,
+                       vector<vector<int>> &cubes) {
+  for (auto lit : cube)
+    solver->assume (lit);
+  auto split = solver->generate_cubes (resplit);
+  solver->reset_assumptions ();
+  if (split.status == 10) {
+    solver->message ("inconclusive cube satisfiable while splitting");
+    for (auto lit : cube)
+      solver->assume (lit);
+    const int res = solver->solve ();
+    if (res == 10) {
+      solver->conclude ();
+      conquered_cubes.inconclusive--;
+      conquered_cubes.satisfiable++;
+    }
+    return res;
+  }
+  if (split.status == 20 || split.cubes.empty ()) {
+    solver->message ("inconclusive cube unsatisfiable while splitting");
+    conquered_cubes.inconclusive--;
+    conquered_cubes.unsatisfiable++;
+    return 20;
+  }
+  for (const auto &other : split.cubes) {
+    bool extended = false;
+    for (auto lit : other)
+      if (find (cube.begin (), cube.end (), lit) == cube.end ())
+        extended = true;
+    if (!extended) {
+      solver->message ("inconclusive cube can not be split");
+      return 0;
+    }
+  }
+  solver->message ("split inconclusive cube into %zu cubes",
+                   split.cubes.size ());
+  conquered_cubes.inconclusive--;
+  conquered_cubes.resplit++;
+  conquered_cubes.cubes += split.cubes.size ();
+  for (auto &other : split.cubes)
+    cubes.push_back (std::move (other));
+  return 0;
+}
+
+void App::conquer_summary (const char *name) {
+  const size_t cubes = conquered_cubes.cubes;
+  const size_t solved = conquered_cubes.solved;
+  solver->section (name);
+  solver->message ("%zu cubes solved %.0f%%", solved,
+                   percent (solved, cubes));
+  solver->message ("%zu cubes inconclusive %.0f%%",
+                   conquered_cubes.inconclusive,
+                   percent (conquered_cubes.inconclusive, solved));
+  solver->message ("%zu cubes unsatisfiable %.0f%%",
+                   conquered_cubes.unsatisfiable,
+                   percent (conquered_cubes.unsatisfiable, solved));
+  solver->message ("%zu cubes satisfiable %.0f%%",
+                   conquered_cubes.satisfiable,
+                   percent (conquered_cubes.satisfiable, solved));
+  if (resplit)
+    solver->message ("%zu cubes split again %.0f%%",
+                     conquered_cubes.resplit,
+                     percent (conquered_cubes.resplit, solved));
+  if (conquer)
+    solver->message ("%zu clauses shared %zu imported",
+                     conquer->exported_clauses (),
+                     conquer->imported_clauses ());
+}
+
+/*------------------------------------------------------------------------*/
+
+// The path of a shard has its index inserted before the first extension of
+// the base name, such that compression by suffix still applies.
+
+static string shard_path (const char *path, int shard) {
+  string res = path;
+  const size_t slash = res.find_last_of ('/');
+  const size_t base = slash == string::npos ? 0 : slash + 1;
+  const size_t dot = res.find ('.', base + 1);
+  const string index = "-" + to_string (shard);
+  if (dot == string::npos)
+    return res + index;
+  return res.insert (dot, index);
+}
+
+// Generate all cubes first, then balance them by estimated difficulty
+// over the shards and write one file per shard.
+
+const char *App::write_shards () {
+  auto cubes = solver->generate_cubes (cubes_depth);
+  if (cubes.status == 10)
+    cubes.cubes.push_back (vector<int> ());
+  solver->message ("generated %zu cubes", cubes.cubes.size ());
+  vector<vector<vector<int>>> sharded;
+  if (cubes.status) {
+    sharded.resize (shards);
+    sharded[0] = std::move (cubes.cubes);
+  } else
+    sharded = solver->shard_cubes (cubes.cubes, shards);
+  for (int i = 0; i < shards; i++) {
+    const string path = shard_path (cubes_path, i);
+    solver->message ("writing %zu cubes of shard %d to %s'%s'%s",
+                     sharded[i].size (), i, tout.green_code (),
+                     path.c_str (), tout.normal_code ());
+    const char *err =
+        solver->write_cubes (path.c_str (), sharded[i], cubes_inccnf);
+    if (err)
+      return err;
+  }
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Solve copies of the formula with differently configured solvers in
+// parallel.  The conflict limit applies to each worker.
+
+int App::solve_portfolio (int conflict_limit) {
+  solver->section ("portfolio");
+  solver->message ("solving with a portfolio of %d threads",
+                   portfolio_threads);
+  const double start = absolute_real_time ();
+  portfolio = new Portfolio (solver, portfolio_threads, this);
+  for (auto arg : worker_options)
+    portfolio->option (arg);
+  portfolio->limit (conflict_limit);
+  const int res = portfolio->solve ();
+  const int winner = portfolio->solved_by ();
+  const double seconds = absolute_real_time () - start;
+  if (winner < 0)
+    solver->message ("no worker solved the formula in %.2f sec", seconds);
+  else
+    solver->message ("worker %d with configuration '%s' solved the formula "
+                     "in %.2f sec",
+                     winner, Portfolio::configuration (winner), seconds);
+  solver->message ("exported %zu units and binary clauses (%zu dropped)",
+                   portfolio->exported_clauses (),
+                   portfolio->dropped_clauses ());
+  solver->message ("imported %zu units and binary clauses",
+                   portfolio->imported_clauses ());
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Called for every solved cube, either directly after solving it
+// incrementally or by the conquer workers (which serialize these calls).
+
+void App::conquered (size_t cube, int res, double seconds) {
+  const size_t solved = ++conquered_cubes.solved;
+  if (res == 10)
+    conquered_cubes.satisfiable++;
+  else if (res == 20)
+    conquered_cubes.unsatisfiable++;
+  else {
+    conquered_cubes.inconclusive++;
+    if (resplit && !timesup)
+      inconclusive_cubes.push_back (cube);
+  }
+  cube += conquered_offset;
+#ifndef QUIET
+  if (get ("quiet"))
+    return;
+  const size_t cubes = conquered_cubes.cubes;
+  const bool reporting = conquered_cubes.reporting;
+  const double sum = conquered_cubes.time += seconds;
+  char buffer[256];
+  snprintf (buffer, sizeof buffer,
+            "%s"
+            "in %.3f sec "
+            "(%.0f%% after %.2f sec at %.0f ms/cube)"
+            "%s",
+            tout.magenta_code (), seconds, percent (solved, cubes), sum,
+            relative (1e3 * sum, solved), tout.normal_code ());
+  if (reporting)
+    solver->message ();
+  const char *cube_str, *status_str, *color_code;
+  if (res == 10) {
+    cube_str = "CUBE";
+    color_code = tout.green_code ();
+    status_str = "SATISFIABLE";
+  } else if (res == 20) {
+    cube_str = "CUBE";
+    color_code = tout.cyan_code ();
+    status_str = "UNSATISFIABLE";
+  } else {
+    cube_str = "cube";
+    color_code = tout.magenta_code ();
+    status_str = "inconclusive";
+  }
+  const char *fmt;
+  if (reporting)
+    fmt = "%s%s %zu %s%s %s";
+  else
+    fmt = "%s%s %zu %-13s%s %s";
+  solver->message (fmt, color_code, cube_str, cube + 1, status_str,
+                   tout.normal_code (), buffer);
+#else
+  (void) cube, (void) seconds, (void) solved;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
 // The real initialization is delayed.
 
 void App::init () {
@@ -924,6 +1415,16 @@ void App::init () {
 #endif
   force_strict_parsing = 1;
   force_writing = false;
+  cube_depth = -1;
+  threads = 1;
+  share = 4;
+  resplit = 0;
+  portfolio_threads = 0;
+  conquered_offset = 0;
+  cubes_path = 0;
+  cubes_inccnf = false;
+  cubes_depth = 10;
+  shards = 1;
   max_var = 0;
   timesup = false;
 
@@ -940,12 +1441,14 @@ void App::init () {
 
 /*------------------------------------------------------------------------*/
 
-App::App () : solver (0) {} // Only partially initialize the app.
+App::App () : solver (0), conquer (0), portfolio (0) {} // Partially.
 
 App::~App () {
   if (!solver)
     return; // Only partially initialized.
   Signal::reset ();
+  delete conquer;
+  delete portfolio;
   delete solver;
 }
 
@@ -1,6 +1,8 @@
 #ifndef _cadical_hpp_INCLUDED
 #define _cadical_hpp_INCLUDED
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <vector>
@@ -205,10 +207,12 @@ struct External;
 // Forward declaration of call-back classes. See bottom of this file.
 
 class Learner;
+class ClauseBuffer;
 class FixedAssignmentListener;
 class Terminator;
 class ClauseIterator;
 class WitnessIterator;
+class CubeIterator;
 class ExternalPropagator;
 class Tracer;
 class InternalTracer;
@@ -369,6 +373,33 @@ public:
   void connect_fixed_listener (FixedAssignmentListener *fixed_listener);
   void disconnect_fixed_listener ();
 
+  // Connect a buffer to which learned clauses with at most 'max_size'
+  // literals and glue at most 'max_glue' are exported (learned units have
+  // glue zero).  The solver is the only producer of connected buffers and
+  // clauses which do not fit into a full buffer are dropped.  Several
+  // buffers can be connected, e.g., one for every other solver in a
+  // portfolio (see 'ClauseBuffer' below).
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_export_buffer (ClauseBuffer *, int max_size, int max_glue);
+  void disconnect_export_buffers ();
+
+  // Connect a buffer from which the solver (as its only consumer) imports
+  // clauses at restarts and reductions during search.  Imported clauses
+  // are added as redundant clauses with the glue given by the producer and
+  // thus have to be implied by the formula without assumptions and
+  // constraints.  Clauses with eliminated or substituted variables are
+  // skipped.  Like clauses added by an external propagator imported
+  // clauses are traced as original clauses in proofs.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_import_buffer (ClauseBuffer *);
+  void disconnect_import_buffers ();
+
   // ====== BEGIN IPASIR-UP ================================================
 
   // Add call-back which allows to learn, propagate and backtrack based on
@@ -479,8 +510,77 @@ public:
     std::vector<std::vector<int>> cubes;
   };
 
+  // Split the formula (under the current assumptions) into cubes of the
+  // given depth by lookahead.  If termination is requested splitting stops
+  // as soon as 'min_depth' is reached.  With 'cubethreads' set to a
+  // positive value, sub-trees below depth 'cubethreadsdepth' are generated
+  // in parallel by that many worker threads on copies of this solver.
+  // With 'cubetarget' set to a positive value the depth is only an upper
+  // bound and branches are split adaptively, deeper for hard and less deep
+  // for easy ones, to produce roughly that many cubes.  The options
+  // 'cubetime', 'cubeprops' and 'cubemax' bound the time, propagations and
+  // number of cubes.  Hitting the time or propagation budget has the same
+  // effect as termination.  The cubes always partition the search space.
+  //
+  //   require (READY)
+  //   ensure (STEADY |SATISFIED|UNSATISFIED)
+  //
   CubesWithStatus generate_cubes (int, int min_depth = 0);
 
+  // Streaming version of 'generate_cubes' which hands out every cube to
+  // the given iterator as soon as it is final, without collecting them.
+  // Returns the status, i.e., '10' or '20' if the formula was solved while
+  // generating cubes and '0' otherwise.
+  //
+  //   require (READY)
+  //   ensure (STEADY |SATISFIED|UNSATISFIED)
+  //
+  int generate_cubes (int, CubeIterator &, int min_depth = 0);
+
+  // Post-pass for generated cubes, which distributes them over the given
+  // number of shards of similar estimated difficulty, e.g., to balance the
+  // work of solving them on different nodes.  The difficulty of a cube is
+  // estimated from the number of free variables after propagating it (as
+  // for 'cubetarget', see also 'cubetargetexp').  Cubes are put into the
+  // shards greedily in the order of decreasing difficulty, thus within a
+  // shard cubes are sorted by decreasing difficulty too.  With one shard
+  // this only sorts the cubes.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  std::vector<std::vector<std::vector<int>>>
+  shard_cubes (const std::vector<std::vector<int>> &cubes, int shards);
+
+  // Write cubes generated as with 'generate_cubes' to the given file as
+  // 'a <lit> ... <lit> 0' lines, which is the format of 'march_cu'.  If
+  // 'inccnf' is true the simplified formula is written first after a 'p
+  // inccnf' header, which gives an incremental CNF file for the stand-alone
+  // solver.  It also contains the clauses learned during cube generation
+  // as traversed by 'traverse_learned_clauses' up to the size given by the
+  // 'cubelearned' option.  Compression is determined by the file name
+  // suffix as for 'write_dimacs'.  Without 'inccnf' cubes are written as
+  // soon as they are generated and otherwise after generation is complete.
+  // If the formula is found to be satisfiable while generating cubes a
+  // single empty cube is written and if unsatisfiable no cube (but the
+  // empty clause in 'inccnf' mode).  The result is zero if writing
+  // succeeded and otherwise an error message.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  const char *write_cubes (const char *path, int depth, bool inccnf = false,
+                           int min_depth = 0);
+
+  // Same for the given cubes, e.g., one of the shards above.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  const char *write_cubes (const char *path,
+                           const std::vector<std::vector<int>> &cubes,
+                           bool inccnf = false);
+
   void reset_assumptions ();
   void reset_constraint ();
 
@@ -860,6 +960,20 @@ public:
   bool traverse_witnesses_backward (WitnessIterator &) const;
   bool traverse_witnesses_forward (WitnessIterator &) const;
 
+  // Traverse clauses implied by the original formula which the solver
+  // derived so far, i.e., all root-level units, the binary clauses on the
+  // extension stack (including all equivalences of substituted variables)
+  // and the learned clauses with at most 'max_size' literals (including
+  // hyper binary resolvents of probing).  Adding these clauses to the
+  // original formula or to the irredundant clauses traversed above keeps
+  // the set of models.  This allows for instance to pass on what was
+  // learned during 'generate_cubes' to the solvers working on the cubes.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  bool traverse_learned_clauses (ClauseIterator &, int max_size = 2) const;
+
   //------------------------------------------------------------------------
   // Files with explicit path argument support compressed input and output
   // if appropriate helper functions 'gzip' etc. are available.  They are
@@ -1068,6 +1182,11 @@ private:
   //
   int call_external_solve_and_check_results (bool preprocess_only);
 
+  // Factored out common code for both versions of 'generate_cubes', which
+  // also dispatches to the parallel cube generator if requested.
+  //
+  int call_generate_cubes (int depth, int min_depth, CubeIterator &);
+
   //------------------------------------------------------------------------
   // Print DIMACS file to '<stdout>' for debugging and testing purposes,
   // including derived units and assumptions.  Since it will print in terms
@@ -1093,6 +1212,13 @@ private:
   friend struct ObserveCall;
   friend struct DisconnectCall;
   friend class MockPropagator;
+
+  /*----------------------------------------------------------------------*/
+
+  // The parallel cube generator in 'cuber.cpp' copies the solver into
+  // worker solvers and adjusts their options after copying.
+  //
+  friend class Cuber;
 };
 
 /*========================================================================*/
@@ -1119,6 +1245,42 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Bounded single-producer single-consumer ring buffer of clauses to share
+// clauses between solvers running in different threads without locking
+// and without virtual calls per literal (see 'connect_export_buffer' and
+// 'connect_import_buffer' above).  The producer only moves 'tail' and the
+// consumer only 'head'.  Clauses are stored as size, glue and literals.
+// The counters are only updated by the producer ('pushed' and 'dropped')
+// respectively the consumer ('popped') and thus should only be read by
+// the other side after synchronizing, e.g., after joining its thread.
+
+class ClauseBuffer {
+  int *data;
+  size_t capacity; // In integers (at least 'max_size + 2').
+  std::atomic<size_t> head, tail;
+  size_t pushed_clauses, dropped_clauses, popped_clauses;
+
+  ClauseBuffer (const ClauseBuffer &) = delete;
+  ClauseBuffer &operator= (const ClauseBuffer &) = delete;
+
+public:
+  ClauseBuffer (size_t capacity = 1 << 16);
+  ~ClauseBuffer ();
+
+  // Producer: returns 'false' if the clause was dropped (buffer full).
+  //
+  bool push (const int *literals, size_t size, int glue);
+
+  // Consumer: returns 'false' if the buffer is empty.
+  //
+  bool pop (std::vector<int> &clause, int &glue);
+  bool empty () const;
+
+  size_t pushed () const { return pushed_clauses; }
+  size_t dropped () const { return dropped_clauses; }
+  size_t popped () const { return popped_clauses; }
+};
+
 // Connected listener gets notified whenever the truth value of a variable is
 // fixed (for example during inprocessing or due to some derived unit clauses).
 
@@ -1273,6 +1435,21 @@ public:
 
 /*------------------------------------------------------------------------*/
 
+// Receives the cubes produced by 'generate_cubes' one after the other as
+// soon as they are final, i.e., before the remaining cubes are generated.
+// The literals of each cube are external literals and include the
+// assumptions active when cube generation started.
+//
+// If 'cube' returns false cube generation aborts early.
+
+class CubeIterator {
+public:
+  virtual ~CubeIterator () {}
+  virtual bool cube (const std::vector<int> &) = 0;
+};
+
+/*------------------------------------------------------------------------*/
+
 } // namespace CaDiCaL
 
 #endif
@@ -73,7 +73,7 @@ void Internal::mark_added (Clause *c) {
 
 /*------------------------------------------------------------------------*/
 
-Clause *Internal::new_clause (bool red, int glue) {
+Clause *Internal::new_clause (bool red, int glue, uint64_t id) {
 
   assert (clause.size () <= (size_t) INT_MAX);
   const int size = (int) clause.size ();
@@ -93,9 +93,13 @@ Clause *Internal::new_clause (bool red, int glue) {
     keep = false;
 
   size_t bytes = Clause::bytes (size);
+#ifdef COMPACT
+  Clause *c = (Clause *) ClauseSpace::allocate (bytes);
+#else
   Clause *c = (Clause *) new char[bytes];
+#endif
 
-  c->id = ++clause_id;
+  c->id = id ? id : ++clause_id;
 
   c->conditioned = false;
   c->covered = false;
@@ -205,6 +209,10 @@ size_t Internal::shrink_clause (Clause *c, int new_size) {
   c->size = new_size;
   size_t new_bytes = c->bytes ();
   size_t res = old_bytes - new_bytes;
+#ifdef COMPACT
+  if (res && !arena.contains (c))
+    ClauseSpace::deallocate ((char *) c + new_bytes, res);
+#endif
 
   if (c->redundant)
     promote_clause (c, min (c->size - 1, c->glue));
@@ -229,7 +237,11 @@ void Internal::deallocate_clause (Clause *c) {
   if (arena.contains (p))
     return;
   LOG (c, "deallocate pointer %p", (void *) c);
+#ifdef COMPACT
+  ClauseSpace::deallocate (p, c->bytes ());
+#else
   delete[] p;
+#endif
 }
 
 void Internal::delete_clause (Clause *c) {
@@ -497,9 +509,7 @@ void Internal::add_new_original_clause (uint64_t id) {
       int glue = (int) (learned_levels.size () + unassigned);
       assert (glue <= (int) clause.size ());
       bool clause_redundancy = from_propagator && ext_clause_forgettable;
-      Clause *c = new_clause (clause_redundancy, glue);
-      c->id = new_id;
-      clause_id--;
+      Clause *c = new_clause (clause_redundancy, glue, new_id);
       watch_clause (c);
       clause.clear ();
       original.clear ();
@@ -203,7 +203,7 @@ inline void Internal::flush_watches (int lit, Watches &saved) {
       continue;
     if (c->moved)
       c = w.clause = c->copy;
-    w.size = c->size;
+    w.update (lit, c);
     const int new_blit_pos = (c->literals[0] == lit);
     LOG (c, "clause in flush_watch starting from %d", lit);
     assert (c->literals[!new_blit_pos] == lit); /*FW1*/
@@ -493,7 +493,7 @@ void Internal::remove_garbage_binaries () {
         if (c->collect ())
           continue;
         assert (!c->moved);
-        w.size = c->size;
+        w.update (lit, c);
         const int new_blit_pos = (c->literals[0] == lit);
         LOG (c, "clause in flush_watch starting from %d", lit);
         assert (c->literals[!new_blit_pos] == lit); /*FW1*/
@@ -278,12 +278,16 @@ void Internal::compact () {
     }
   }
 
-  // Map the blocking literals in all watches.
+  // Map the blocking literals in all watches and recompute the inlined
+  // literals of ternary clauses (their literals are already mapped).
   //
   if (!wtab.empty ())
     for (auto lit : lits)
-      for (auto &w : watches (lit))
+      for (auto &w : watches (lit)) {
         w.blit = mapper.map_lit (w.blit);
+        if (w.ternary ())
+          w.update (mapper.map_lit (lit), w.clause);
+      }
 
   // We first flush inactive variables and map the links in the queue.  This
   // has to be done before we map the actual links data structure 'links'.
@@ -400,7 +404,8 @@ void Internal::compact () {
   // Special case for 'val' as for 'val' we trade branch less code for
   // memory and always allocated an [-maxvar,...,maxvar] array.
   {
-    signed char *new_vals = new signed char[2 * mapper.new_vsize];
+    signed char *new_vals =
+        new signed char[2 * mapper.new_vsize + simd_vals_padding];
     ignore_clang_analyze_memory_leak_warning = new_vals;
     new_vals += mapper.new_vsize;
     for (auto src : vars)
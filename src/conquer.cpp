@@ -0,0 +1,242 @@
+#include "conquer.hpp"
+#include "pool.hpp"
+#include "resources.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <system_error>
+#include <thread>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// Capacity of each buffer in integers (as in 'Portfolio').
+
+static const size_t buffer_capacity = 1 << 14;
+
+Conquer::Conquer (Solver *s, int t, Terminator *e, ConquerHandler *h)
+    : solver (s), threads (std::max (1, t)), terminator (e), handler (h),
+      conflicts (-1), decisions (-1), share_size (0), workers (0),
+      cubes (0), next (0), done (false), res (0), unsatisfiable (0) {}
+
+Conquer::~Conquer () { delete_buffers (); }
+
+void Conquer::delete_buffers () {
+  for (auto buffer : buffers)
+    delete buffer;
+  buffers.clear ();
+}
+
+void Conquer::limit (int c, int d) { conflicts = c, decisions = d; }
+
+void Conquer::share (int s) { share_size = std::max (0, s); }
+
+int Conquer::val (int lit) const {
+  assert (res == 10);
+  const int idx = abs (lit);
+  if (idx >= (int) model.size ())
+    return -lit;
+  return model[idx] == idx ? lit : -lit;
+}
+
+bool Conquer::terminate () {
+  if (done)
+    return true;
+  if (!terminator)
+    return false;
+  std::lock_guard<std::mutex> guard (terminating);
+  return terminator->terminate ();
+}
+
+// Constructing, copying and deleting solvers touches static state (API
+// tracing through environment variables, terminal setup and the report
+// default) and copying traverses the shared solver.  Thus we serialize it.
+
+// Copies learned clauses of the solver, e.g., found while generating the
+// cubes, as irredundant clauses to a worker.
+
+struct LearnedCopier : public ClauseIterator {
+  Solver *worker;
+  LearnedCopier (Solver *w) : worker (w) {}
+  bool clause (const std::vector<int> &c) {
+    for (const auto &lit : c)
+      worker->add (lit);
+    worker->add (0);
+    return true;
+  }
+};
+
+Solver *Conquer::new_worker () {
+  std::lock_guard<std::mutex> guard (copying);
+  Solver *worker = new Solver ();
+  solver->copy (*worker);
+  const int max_size = solver->get ("cubelearned");
+  if (max_size) {
+    LearnedCopier copier (worker);
+    solver->traverse_learned_clauses (copier, max_size);
+  }
+  worker->set ("quiet", 1);
+  worker->connect_terminator (this);
+  return worker;
+}
+
+void Conquer::delete_worker (Solver *worker) {
+  std::lock_guard<std::mutex> guard (copying);
+  worker->disconnect_terminator ();
+  delete worker;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Learned clauses are exported by the worker during search and thus only
+// connected if learned clauses are shared at all, while the clauses of
+// failed cubes are always exported (by 'export_failed').
+
+void Conquer::connect_buffers (int id, Solver *worker) {
+  for (int other = 0; other < workers; other++) {
+    if (other == id)
+      continue;
+    if (share_size)
+      worker->connect_export_buffer (buffers[id * workers + other],
+                                     share_size, share_size);
+    worker->connect_import_buffer (buffers[other * workers + id]);
+  }
+}
+
+void Conquer::disconnect_buffers (Solver *worker) {
+  worker->disconnect_export_buffers ();
+  worker->disconnect_import_buffers ();
+}
+
+// Called by worker 'id' between solving cubes, when its solver does not
+// export clauses, thus it remains the only producer of its buffers.  All
+// failed literals are assumption decisions and thus the glue of the clause
+// is its size.
+
+void Conquer::export_failed (int id, const std::vector<int> &clause) {
+  for (int other = 0; other < workers; other++)
+    if (other != id)
+      buffers[id * workers + other]->push (clause.data (), clause.size (),
+                                           (int) clause.size ());
+}
+
+/*------------------------------------------------------------------------*/
+
+void Conquer::work (int id) {
+  Solver *worker = 0;
+  std::vector<int> failed;
+  while (!terminate ()) {
+    const size_t i = next++;
+    if (i >= cubes->size ())
+      break;
+    if (!worker) {
+      worker = new_worker ();
+      connect_buffers (id, worker);
+    }
+    const std::vector<int> &cube = (*cubes)[i];
+    for (const auto &lit : cube)
+      worker->assume (lit);
+    if (conflicts >= 0)
+      worker->limit ("conflicts", conflicts);
+    if (decisions >= 0)
+      worker->limit ("decisions", decisions);
+    const double start = absolute_real_time ();
+    const int tmp = worker->solve ();
+    const double seconds = absolute_real_time () - start;
+    if (tmp == 20) {
+      for (const auto &lit : cube)
+        if (worker->failed (lit))
+          failed.push_back (-lit);
+      for (const auto &lit : failed)
+        worker->add (lit);
+      worker->add (0);
+      if (!failed.empty ())
+        export_failed (id, failed);
+    }
+    std::lock_guard<std::mutex> guard (reporting);
+    if (!tmp && done)
+      continue; // Interrupted since another worker finished.
+    if (tmp == 10 && !done) {
+      const int max_var = worker->vars ();
+      model.resize (max_var + 1);
+      for (int idx = 1; idx <= max_var; idx++)
+        model[idx] = worker->val (idx);
+      res = 10;
+      done = true;
+    } else if (tmp == 20 && failed.empty () && !done) {
+      res = 20; // Formula unsatisfiable even without cube.
+      done = true;
+    }
+    failed.clear ();
+    if (tmp == 20)
+      unsatisfiable++;
+    if (handler)
+      handler->conquered (i, tmp, seconds);
+  }
+  if (worker) {
+    disconnect_buffers (worker);
+    delete_worker (worker);
+  }
+}
+
+int Conquer::solve (const std::vector<std::vector<int>> &c) {
+  cubes = &c;
+  next = 0;
+  done = false;
+  res = 0;
+  unsatisfiable = 0;
+  model.clear ();
+
+  workers =
+      (int) capped_threads (std::min ((size_t) threads, cubes->size ()));
+  delete_buffers ();
+  for (int i = 0; i < workers; i++)
+    for (int j = 0; j < workers; j++)
+      buffers.push_back (i == j ? 0 : new ClauseBuffer (buffer_capacity));
+
+  // If creating worker threads fails we continue with the workers started
+  // so far (clauses exported to the missing ones are just dropped), or
+  // solve all cubes in this thread if none could be started.
+
+  std::vector<std::thread> running;
+  try {
+    for (int i = 0; i < workers; i++)
+      running.emplace_back (&Conquer::work, this, i);
+  } catch (const std::system_error &) {
+    if (running.empty ())
+      work (0);
+  }
+  for (auto &thread : running)
+    thread.join ();
+
+  if (!res && !cubes->empty () && unsatisfiable == cubes->size ())
+    res = 20;
+  cubes = 0;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Only called after all worker threads have been joined.
+
+size_t Conquer::exported_clauses () const {
+  size_t res = 0;
+  for (const auto &buffer : buffers)
+    if (buffer)
+      res += buffer->pushed ();
+  return res;
+}
+
+size_t Conquer::imported_clauses () const {
+  size_t res = 0;
+  for (const auto &buffer : buffers)
+    if (buffer)
+      res += buffer->popped ();
+  return res;
+}
+
+} // namespace CaDiCaL
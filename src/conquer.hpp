@@ -0,0 +1,120 @@
+#ifndef _conquer_hpp_INCLUDED
+#define _conquer_hpp_INCLUDED
+
+#include "cadical.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Helper classes for solving cubes in parallel ('cube and conquer') in
+// applications.  Every worker thread copies the formula of the given
+// solver once and then repeatedly takes the next unsolved cube and solves
+// it incrementally with the cube literals as assumptions.  If the cube is
+// unsatisfiable the negation of its failed literals is added as clause to
+// that worker.  Taking cubes dynamically from a shared counter keeps all
+// workers busy even if cubes are of very different difficulty.  The first
+// satisfiable cube stops all workers through the 'Terminator' interface
+// and its model is kept.  Workers do not trace proofs.  Besides the
+// formula workers also copy the clauses learned by the solver up to the
+// size given by its 'cubelearned' option (see 'traverse_learned_clauses'),
+// which includes hyper binary resolvents found while generating cubes.
+// The number of workers is capped by the number of hardware threads and
+// if creating a worker thread fails, the workers started so far (or the
+// calling thread) solve all cubes.
+
+// The clauses of failed cubes and short learned clauses are shared with
+// the other workers through one single-producer single-consumer
+// 'ClauseBuffer' for each ordered pair of workers (as in 'Portfolio').
+// Learned clauses are exported by the solver itself during search and
+// failed cube clauses by the worker after solving a cube.  Workers import
+// shared clauses as redundant clauses at restarts and reductions, thus
+// also while solving a cube.  All these clauses are implied by the formula
+// without assumptions and thus sound to import.
+
+// The handler is called for every cube which was tried with the index of
+// the cube, the result and the wall clock time used.  Calls are serialized
+// across workers, thus the handler can print messages safely.
+
+class ConquerHandler {
+public:
+  ConquerHandler () {}
+  virtual ~ConquerHandler () {}
+  virtual void conquered (size_t cube, int res, double seconds) = 0;
+};
+
+class Conquer : public Terminator {
+
+  Solver *solver;          // Copied by the workers.
+  int threads;             // Maximum number of worker threads.
+  Terminator *terminator;  // Optional external terminator.
+  ConquerHandler *handler; // Optional handler for results.
+
+  int conflicts, decisions; // Limits per cube (negative if unlimited).
+  int share_size;           // Maximum size of shared learned clauses.
+  int workers;              // Number of workers in the current 'solve'.
+
+  const std::vector<std::vector<int>> *cubes;
+  std::atomic<size_t> next; // Next cube to solve.
+  std::atomic<bool> done;   // Satisfiable cube found or formula refuted.
+  int res;                  // Overall result.
+  size_t unsatisfiable;     // Number of unsatisfiable cubes.
+
+  std::vector<int> model; // Of the satisfiable cube.
+
+  // Buffer 'buffers[i * workers + j]' from worker 'i' to worker 'j'.
+  //
+  std::vector<ClauseBuffer *> buffers;
+  void delete_buffers ();
+
+  std::mutex copying;     // Serializes creating and deleting workers.
+  std::mutex reporting;   // Serializes results and handler calls.
+  std::mutex terminating; // Serializes calls to the external terminator.
+
+  Solver *new_worker ();
+  void delete_worker (Solver *);
+  void connect_buffers (int id, Solver *);
+  void disconnect_buffers (Solver *);
+  void export_failed (int id, const std::vector<int> &clause);
+  void work (int id);
+
+public:
+  Conquer (Solver *, int threads, Terminator * = 0, ConquerHandler * = 0);
+  ~Conquer ();
+
+  // Set conflict and decision limits for each cube (negative means none).
+  //
+  void limit (int conflicts, int decisions);
+
+  // Set the maximum size of shared learned clauses (zero means only share
+  // clauses of failed cubes).
+  //
+  void share (int size);
+
+  // Returns '10' if a cube is satisfiable, '20' if all cubes are
+  // unsatisfiable and '0' otherwise.
+  //
+  int solve (const std::vector<std::vector<int>> &cubes);
+
+  // Result of the last call to 'solve'.
+  //
+  int status () const { return res; }
+
+  // Model of the first satisfiable cube (as 'Solver::val').
+  //
+  int val (int lit) const;
+
+  // Number of exported and imported clauses (counted once for every
+  // receiving worker).
+  //
+  size_t exported_clauses () const;
+  size_t imported_clauses () const;
+
+  bool terminate ();
+};
+
+} // namespace CaDiCaL
+
+#endif
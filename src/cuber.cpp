@@ -0,0 +1,155 @@
+#include "internal.hpp"
+
+#include <thread>
+
+namespace CaDiCaL {
+
+Cuber::Cuber (Solver *s, External *e)
+    : solver (s), internal (e->internal), external (e), depth (0),
+      min_depth (0), target (0), max (0), props (0), next (0), aborted (false) {}
+
+// Worker solvers are fresh copies of the master solver.  Constructing and
+// deleting solvers touches static state (API tracing through environment
+// variables and terminal setup) and copying traverses the master.  Thus we
+// serialize all of it.
+
+Solver *Cuber::new_worker () {
+  std::lock_guard<std::mutex> guard (copying);
+  Solver *worker = new Solver ();
+  solver->copy (*worker);
+  Options &opts = worker->internal->opts;
+  opts.cubethreads = 0;
+  opts.cubetarget = target;
+  opts.cubemax = max;
+  opts.cubeprops = props;
+  opts.cubetime = 0;
+  opts.quiet = 1;
+  opts.report = 0;
+  opts.verbose = 0;
+  worker->connect_terminator (this);
+  return worker;
+}
+
+void Cuber::delete_worker (Solver *worker) {
+  std::lock_guard<std::mutex> guard (copying);
+  const Stats &stats = worker->internal->stats;
+  internal->stats.cube.nodes += stats.cube.nodes;
+  internal->stats.cube.cheap += stats.cube.cheap;
+  internal->stats.cube.cubes += stats.cube.cubes;
+  internal->stats.cube.probes += stats.cube.probes;
+  internal->stats.cube.cached += stats.cube.cached;
+  internal->stats.cube.doubles += stats.cube.doubles;
+  internal->stats.cube.dfailed += stats.cube.dfailed;
+  worker->disconnect_terminator ();
+  delete worker;
+}
+
+bool Cuber::terminate () {
+  if (aborted)
+    return true;
+  std::lock_guard<std::mutex> guard (terminating);
+  if (internal->termination_forced)
+    return true;
+  if (internal->lim.cube.time &&
+      absolute_real_time () >= internal->lim.cube.time)
+    return true;
+  return external->terminator && external->terminator->terminate ();
+}
+
+void Cuber::work () {
+  for (;;) {
+    const size_t i = next++;
+    if (i >= frontier.size ())
+      break;
+    const std::vector<int> &cube = frontier[i];
+    std::vector<std::vector<int>> cubes;
+    int res = 0;
+    if (!aborted) {
+      Solver *worker = new_worker ();
+      for (const auto &lit : cube)
+        worker->assume (lit);
+      CubeCollector collector;
+      res = worker->generate_cubes (depth, collector, min_depth);
+      delete_worker (worker);
+      cubes = std::move (collector.cubes);
+      if (res == 20)
+        cubes.clear ();
+      else if (res == 10 || cubes.empty ())
+        cubes.push_back (cube);
+      else
+        for (auto &c : cubes)
+          if (c.empty ())
+            c = cube; // Worker had no active variable left.
+    }
+    std::lock_guard<std::mutex> guard (finishing);
+    results[i] = std::move (cubes);
+    status[i] = res;
+    done[i] = true;
+    finished.notify_all ();
+  }
+}
+
+int Cuber::generate (int d, int md, CubeIterator &it) {
+  const Options &opts = internal->opts;
+  const int split = std::min (d, (int) opts.cubethreadsdepth);
+  if (split == d)
+    return external->generate_cubes (d, md, it);
+
+  CubeCollector collector;
+  int res = external->generate_cubes (split, std::min (md, split),
+                                      collector);
+  if (res || collector.cubes.empty ())
+    return res;
+
+  frontier = std::move (collector.cubes);
+  depth = d - split;
+  min_depth = std::max (0, md - split);
+  const int64_t n = frontier.size ();
+  if (opts.cubetarget)
+    target = std::max<int64_t> (1, opts.cubetarget / n);
+  if (opts.cubemax)
+    max = std::max<int64_t> (1, opts.cubemax / n);
+  if (opts.cubeprops)
+    props = std::max<int64_t> (1, opts.cubeprops / n);
+  internal->stats.cube.cubes -= n; // Only counted as generated by workers.
+  results.resize (frontier.size ());
+  status.resize (frontier.size (), 0);
+  done.resize (frontier.size (), false);
+  next = 0;
+
+  const size_t threads =
+      std::min ((size_t) opts.cubethreads, frontier.size ());
+  VERBOSE (2, "extending %zu frontier cubes of depth %d with %zu threads",
+           frontier.size (), split, threads);
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < threads; i++)
+    workers.emplace_back (&Cuber::work, this);
+
+  // Hand out sub-trees in frontier order as soon as they are complete.
+
+  res = 20;
+  for (size_t i = 0; i < frontier.size (); i++) {
+    std::vector<std::vector<int>> cubes;
+    {
+      std::unique_lock<std::mutex> guard (finishing);
+      finished.wait (guard, [this, i] { return done[i]; });
+      cubes = std::move (results[i]);
+    }
+    if (status[i] == 20)
+      continue;
+    res = 0;
+    for (const auto &cube : cubes)
+      if (!aborted && !it.cube (cube))
+        aborted = true;
+  }
+
+  for (auto &worker : workers)
+    worker.join ();
+
+  VERBOSE (2, "generated cubes of %zu sub-trees in parallel",
+           frontier.size ());
+  return res;
+}
+
+} // namespace CaDiCaL
@@ -0,0 +1,80 @@
+#ifndef _cuber_hpp_INCLUDED
+#define _cuber_hpp_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Parallel cube generation (enabled with 'cubethreads').  The master solver
+// first splits the formula sequentially with lookahead down to the depth
+// given by 'cubethreadsdepth'.  The cubes of this frontier are independent
+// sub-problems.  Each of them is extended to the requested depth by a fresh
+// copy of the master solver, which assumes the frontier cube and then runs
+// the ordinary sequential cube generator.  Worker threads pick the next
+// frontier cube from a shared counter, so idle threads take over remaining
+// sub-trees of busy ones.  Since every sub-tree is generated by a fresh
+// copy and results are concatenated in frontier order, the produced cubes
+// do not depend on the number of threads nor on scheduling.
+// With adaptive depth ('cubetarget') the target number of cubes is split
+// evenly over the frontier cubes, and so are the budgets on the number of
+// cubes ('cubemax') and propagations ('cubeprops').  The time budget
+// ('cubetime') of the master is checked by the workers through 'terminate'.
+//
+// The cubes of a sub-tree are handed out to the iterator by the calling
+// thread as soon as that sub-tree and all sub-trees before it are done.
+
+struct External;
+struct Internal;
+
+// Collects cubes into a vector (for the frontier and sub-trees).
+
+struct CubeCollector : public CubeIterator {
+  std::vector<std::vector<int>> cubes;
+  bool cube (const std::vector<int> &c) {
+    cubes.push_back (c);
+    return true;
+  }
+};
+
+class Cuber : public Terminator {
+
+  Solver *solver; // The master solver.
+  Internal *internal;
+  External *external;
+
+  int depth, min_depth; // Remaining depths below the frontier.
+  int target;           // Adaptive target cubes per frontier cube.
+  int max, props;       // Cube and propagation budgets per frontier cube.
+
+  std::vector<std::vector<int>> frontier;
+  std::vector<std::vector<std::vector<int>>> results;
+  std::vector<int> status;
+  std::vector<bool> done;
+
+  std::atomic<size_t> next;  // Next frontier cube to split.
+  std::atomic<bool> aborted; // Iterator asked to stop.
+  std::mutex copying;        // Serializes creating and deleting workers.
+  std::mutex terminating;    // Serializes calls to the master terminator.
+  std::mutex finishing;      // Protects 'results', 'status' and 'done'.
+  std::condition_variable finished;
+
+  Solver *new_worker ();
+  void delete_worker (Solver *);
+  void work ();
+
+public:
+  Cuber (Solver *, External *);
+
+  int generate (int depth, int min_depth, CubeIterator &);
+
+  // Forwards termination requests of the master solver to the workers.
+  //
+  bool terminate ();
+};
+
+} // namespace CaDiCaL
+
+#endif
@@ -702,7 +702,10 @@ void Internal::try_to_eliminate_variable (Eliminator &eliminator,
     find_gate_clauses (eliminator, pivot);
 
   if (!unsat && !val (pivot)) {
-    if (elim_resolvents_are_bounded (eliminator, pivot)) {
+    int bounded = elim_counted_resolvents_are_bounded (eliminator, pivot);
+    if (!bounded)
+      bounded = elim_resolvents_are_bounded (eliminator, pivot) ? 1 : -1;
+    if (bounded > 0) {
       LOG ("number of resolvents on %d are bounded", pivot);
       elim_add_resolvents (eliminator, pivot);
       if (!unsat)
@@ -719,6 +722,54 @@ void Internal::try_to_eliminate_variable (Eliminator &eliminator,
 
 /*------------------------------------------------------------------------*/
 
+// Pick the next batch of candidates for 'elim_count_batch' from the front
+// of the schedule, which pairwise do not occur in the same clause.
+
+void Internal::elim_schedule_batch (Eliminator &eliminator) {
+  ElimSchedule &schedule = eliminator.schedule;
+  vector<bool> &touched = eliminator.touched;
+  vector<ElimCount> &batch = eliminator.batch;
+  if (touched.size () <= (size_t) max_var)
+    touched.resize (max_var + 1u, false);
+  batch.clear ();
+  vector<int> deferred, neighbors;
+  while (batch.size () < (size_t) opts.elimbatch &&
+         deferred.size () < (size_t) opts.elimbatch && !schedule.empty ()) {
+    const int idx = schedule.front ();
+    schedule.pop_front ();
+    flags (idx).elim = false;
+    if (touched[idx]) {
+      deferred.push_back (idx);
+      continue;
+    }
+    for (int sign = -1; sign <= 1; sign += 2)
+      for (const auto &c : occs (sign * idx)) {
+        if (c->garbage)
+          continue;
+        for (const auto &lit : *c) {
+          const int other = abs (lit);
+          if (touched[other])
+            continue;
+          touched[other] = true;
+          neighbors.push_back (other);
+        }
+      }
+    ElimCount count;
+    count.pivot = idx;
+    count.bounded = 0;
+    batch.push_back (count);
+  }
+  for (const auto &idx : neighbors)
+    touched[idx] = false;
+  for (const auto &idx : deferred)
+    schedule.push_back (idx);
+  stats.elimbatches++;
+  LOG ("scheduled batch of %zu independent candidates (%zu deferred)",
+       batch.size (), deferred.size ());
+}
+
+/*------------------------------------------------------------------------*/
+
 void Internal::
     mark_redundant_clauses_with_eliminated_variables_as_garbage () {
   for (const auto &c : clauses) {
@@ -864,17 +915,40 @@ int Internal::elim_round (bool &completed) {
 
   // Main loops tries to eliminate variables according to the schedule. The
   // schedule is updated dynamically and variables are potentially
-  // rescheduled to be tried again if they occur in a removed clause.
+  // rescheduled to be tried again if they occur in a removed clause.  With
+  // 'elimcountthreads' candidates are taken from the schedule in batches
+  // of independent variables for which resolvents are counted in parallel
+  // (see 'elimpar.cpp').  Only counting is parallel, resolvents are still
+  // added sequentially.
   //
 #ifndef QUIET
   int64_t tried = 0;
 #endif
+  const vector<ElimCount> &batch = eliminator.batch;
+  size_t next = 0;
+  if (opts.elimcountthreads)
+    eliminator.pool.start (opts.elimcountthreads);
   while (!unsat && !terminated_asynchronously () &&
-         stats.elimres <= resolution_limit && !schedule.empty ()) {
-    int idx = schedule.front ();
-    schedule.pop_front ();
-    flags (idx).elim = false;
+         stats.elimres <= resolution_limit &&
+         (next < batch.size () || !schedule.empty ())) {
+    int idx;
+    if (opts.elimcountthreads) {
+      if (next == batch.size ()) {
+        elim_count_batch (eliminator);
+        next = 0;
+      }
+      const ElimCount &count = batch[next++];
+      idx = count.pivot;
+      if (schedule.contains (idx))
+        continue; // Rescheduled and thus tried later again anyhow.
+      eliminator.count = &count;
+    } else {
+      idx = schedule.front ();
+      schedule.pop_front ();
+      flags (idx).elim = false;
+    }
     try_to_eliminate_variable (eliminator, idx);
+    eliminator.count = 0;
 #ifndef QUIET
     tried++;
 #endif
@@ -884,6 +958,14 @@ int Internal::elim_round (bool &completed) {
     garbage_collection ();
   }
 
+  // Candidates of an interrupted batch have not been tried yet.
+  //
+  while (next < batch.size ()) {
+    const int idx = batch[next++].pivot;
+    if (active (idx) && !schedule.contains (idx))
+      schedule.push_back (idx);
+  }
+
   // If the schedule is empty all variables have been tried (even
   // rescheduled ones).  Otherwise asynchronous termination happened or we
   // ran into the resolution limit (or derived unsatisfiability).
@@ -2,6 +2,7 @@
 #define _elim_hpp_INCLUDED
 
 #include "heap.hpp" // Alphabetically after 'elim.hpp'.
+#include "pool.hpp" // Alphabetically after 'elim.hpp'.
 
 namespace CaDiCaL {
 
@@ -15,12 +16,26 @@ struct elim_more {
 
 typedef heap<elim_more> ElimSchedule;
 
+// Resolvents of an elimination candidate counted by a worker thread (see
+// 'elimpar.cpp') together with its occurrences at that point, in order to
+// determine whether the count is still valid when the candidate is tried.
+
+struct ElimCount {
+  int pivot;
+  int64_t fixed;       // Root-level units when counted.
+  int64_t pos, neg;    // Irredundant occurrences of 'pivot' and '-pivot'.
+  int64_t literals;    // Literals in these occurrences.
+  int64_t resolutions; // Resolved clauses during counting.
+  signed char bounded; // Positive if bounded, negative if not, else unknown.
+};
+
 struct Eliminator {
 
   Internal *internal;
   ElimSchedule schedule;
 
-  Eliminator (Internal *i) : internal (i), schedule (elim_more (i)) {}
+  Eliminator (Internal *i)
+      : internal (i), schedule (elim_more (i)), count (0) {}
   ~Eliminator ();
 
   queue<Clause *> backward;
@@ -30,6 +45,12 @@ struct Eliminator {
 
   vector<Clause *> gates;
   vector<int> marked;
+
+  const ElimCount *count;            // Of the current candidate (if any).
+  vector<ElimCount> batch;           // Counted independent candidates.
+  vector<bool> touched;              // Variables in clauses of 'batch'.
+  WorkerPool pool;                   // Started for the whole round.
+  vector<vector<signed char>> marks; // Literal marks of worker threads.
 };
 
 } // namespace CaDiCaL
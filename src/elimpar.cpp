@@ -0,0 +1,186 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <atomic>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// With 'elimcountthreads' set the elimination schedule is processed in
+// batches of candidates which pairwise do not occur together in an
+// irredundant clause, i.e., which form an independent set in the
+// occurrence graph.  This greedy coloring of the occurrence graph only
+// picks one color class at a time from the front of the schedule, while
+// candidates conflicting with already picked ones are rescheduled (see
+// 'elim_schedule_batch').
+
+// Counting the non-tautological resolvents of each candidate, which is
+// the dominating cost of bounded variable elimination, is then performed
+// concurrently by worker threads on the frozen clause database with thread
+// local marks.  The workers are started once per elimination round (see
+// 'WorkerPool') and each takes the next uncounted candidate of the batch.
+// Since this can not use 'resolve_clauses' (which simplifies clauses
+// on-the-fly) the count is considered unknown if counting comes across a
+// satisfied antecedent, a unit or empty resolvent or a resolvent
+// subsuming an antecedent.  The candidates are then tried sequentially in
+// schedule order and the count is only used if the occurrences of the
+// candidate did not change in the meantime, which rarely happens for
+// independent candidates.  Otherwise (or if the count is unknown) the
+// usual 'elim_resolvents_are_bounded' is applied.  Thus adding resolvents
+// and all other changes of the clause database are performed sequentially
+// in the same deterministic order independent of the number of threads.
+
+/*------------------------------------------------------------------------*/
+
+// Read-only variant of 'elim_resolvents_are_bounded' and 'resolve_clauses'
+// without gates executed by worker threads.  It only accesses the given
+// 'marks' and the count, besides reading clauses and values.
+
+void Internal::elim_count_resolvents (ElimCount &count,
+                                      signed char *marks) {
+  const int pivot = count.pivot;
+  count.fixed = stats.all.fixed;
+  count.pos = count.neg = count.literals = count.resolutions = 0;
+  count.bounded = 0;
+  if (!active (pivot))
+    return;
+  const Occs &ps = occs (pivot);
+  const Occs &ns = occs (-pivot);
+  for (const auto &c : ps)
+    if (!c->garbage)
+      count.pos++, count.literals += c->size;
+  for (const auto &d : ns)
+    if (!d->garbage)
+      count.neg++, count.literals += d->size;
+  if (!count.pos || !count.neg) {
+    count.bounded = lim.elimbound >= 0 ? 1 : -1;
+    return;
+  }
+  if (max (count.pos, count.neg) > opts.elimocclim)
+    return; // Rejected cheaply in 'try_to_eliminate_variable'.
+  const int64_t bound = count.pos + count.neg + lim.elimbound;
+  int64_t resolvents = 0;
+  bool unknown = false, unbounded = false;
+  for (const auto &c : ps) {
+    if (c->garbage)
+      continue;
+    int s = 1, size_c = 0;
+    for (const auto &lit : *c) {
+      if (lit == pivot)
+        continue;
+      const signed char tmp = val (lit);
+      if (tmp > 0)
+        unknown = true;
+      else if (!tmp)
+        marks[abs (lit)] = sign (lit), s++, size_c++;
+    }
+    for (const auto &d : ns) {
+      if (unknown || unbounded)
+        break;
+      if (d->garbage)
+        continue;
+      count.resolutions++;
+      int t = 1, size = size_c;
+      bool tautological = false;
+      for (const auto &lit : *d) {
+        if (lit == -pivot)
+          continue;
+        const signed char tmp = val (lit);
+        if (tmp < 0)
+          continue;
+        if (tmp > 0) {
+          unknown = true;
+          break;
+        }
+        const signed char mark = marks[abs (lit)] * sign (lit);
+        if (mark < 0) {
+          tautological = true;
+          break;
+        }
+        if (!mark)
+          size++;
+        t++;
+      }
+      if (unknown || tautological)
+        continue;
+      if (size < 2 || s > size || t > size)
+        unknown = true;
+      else if (size > opts.elimclslim || ++resolvents > bound)
+        unbounded = true;
+    }
+    for (const auto &lit : *c)
+      marks[abs (lit)] = 0;
+    if (unknown || unbounded)
+      break;
+  }
+  if (unknown)
+    count.bounded = 0;
+  else if (unbounded)
+    count.bounded = -1;
+  else
+    count.bounded = 1;
+}
+
+// Schedule the next batch and count resolvents of its candidates.
+
+void Internal::elim_count_batch (Eliminator &eliminator) {
+  elim_schedule_batch (eliminator);
+  vector<ElimCount> &batch = eliminator.batch;
+  const size_t threads = eliminator.pool.size ();
+  vector<vector<signed char>> &marks = eliminator.marks;
+  if (marks.size () < threads)
+    marks.resize (threads);
+  for (size_t i = 0; i < threads; i++)
+    if (marks[i].size () <= (size_t) max_var)
+      marks[i].resize (max_var + 1u, 0);
+  std::atomic<size_t> next (0);
+  eliminator.pool.run ([this, &batch, &marks, &next] (size_t i) {
+    size_t j;
+    while ((j = next++) < batch.size ())
+      elim_count_resolvents (batch[j], marks[i].data ());
+  });
+}
+
+/*------------------------------------------------------------------------*/
+
+// Returns the counted result for the current candidate if the count is
+// known and still valid, i.e., its occurrences did not change, and zero
+// otherwise.  A negative count is also ignored if gates have been found,
+// since substitution only needs resolvents of gate and non-gate clauses.
+// This function is called after occurrences have been flushed.
+
+int Internal::elim_counted_resolvents_are_bounded (Eliminator &eliminator,
+                                                   int pivot) {
+  const ElimCount *count = eliminator.count;
+  if (!count || !count->bounded)
+    return 0;
+  assert (count->pivot == abs (pivot)), (void) pivot;
+  if (count->fixed != stats.all.fixed)
+    return 0;
+  if (count->bounded < 0 && !eliminator.gates.empty ())
+    return 0;
+  const Occs &ps = occs (count->pivot);
+  const Occs &ns = occs (-count->pivot);
+  if ((int64_t) ps.size () != count->pos)
+    return 0;
+  if ((int64_t) ns.size () != count->neg)
+    return 0;
+  int64_t literals = 0;
+  for (const auto &c : ps)
+    literals += c->size;
+  for (const auto &d : ns)
+    literals += d->size;
+  if (literals != count->literals)
+    return 0;
+  LOG ("using counted resolvents of %d (%s)", count->pivot,
+       count->bounded > 0 ? "bounded" : "unbounded");
+  stats.elimtried++;
+  stats.elimcounted++;
+  stats.elimres += count->resolutions;
+  stats.elimrestried += count->resolutions;
+  return count->bounded;
+}
+
+} // namespace CaDiCaL
@@ -561,25 +561,51 @@ int External::lookahead () {
   return elit;
 }
 
-CaDiCaL::CubesWithStatus External::generate_cubes (int depth,
-                                                   int min_depth = 0) {
+int External::generate_cubes (int depth, int min_depth, CubeIterator &it) {
   reset_extended ();
   update_molten_literals ();
   reset_limits ();
-  auto cubes = internal->generate_cubes (depth, min_depth);
-  auto externalize = [this] (int ilit) {
-    const int elit = ilit ? internal->externalize (ilit) : 0;
-    MSG ("lookahead internal %d external %d", ilit, elit);
-    return elit;
-  };
-  auto externalize_map = [this, externalize] (std::vector<int> cube) {
-    (void) this;
-    MSG ("Cube : ");
-    std::for_each (begin (cube), end (cube), externalize);
-  };
-  std::for_each (begin (cubes.cubes), end (cubes.cubes), externalize_map);
-
-  return cubes;
+  return internal->generate_cubes (depth, min_depth, it);
+}
+
+// Distribute cubes over shards of similar estimated cost by greedy
+// bin-packing, i.e., cubes are taken in the order of decreasing cost and
+// put into the shard with the smallest cost so far (the first on ties).
+
+void External::shard_cubes (const vector<vector<int>> &cubes, int shards,
+                            vector<vector<vector<int>>> &res) {
+  assert (shards > 0);
+  reset_extended ();
+  update_molten_literals ();
+  vector<vector<int>> icubes (cubes.size ());
+  for (size_t i = 0; i < cubes.size (); i++)
+    for (const auto &elit : cubes[i]) {
+      const int eidx = abs (elit);
+      int ilit = eidx <= max_var ? e2i[eidx] : 0;
+      if (!ilit)
+        continue;
+      if (elit < 0)
+        ilit = -ilit;
+      icubes[i].push_back (ilit);
+    }
+  vector<double> costs;
+  internal->lookahead_cube_costs (icubes, costs);
+  vector<size_t> order (cubes.size ());
+  for (size_t i = 0; i < order.size (); i++)
+    order[i] = i;
+  stable_sort (order.begin (), order.end (), [&costs] (size_t a, size_t b) {
+    return costs[a] > costs[b];
+  });
+  res.assign (shards, vector<vector<int>> ());
+  vector<double> load (shards, 0);
+  for (const auto &i : order) {
+    int min = 0;
+    for (int j = 1; j < shards; j++)
+      if (load[j] < load[min])
+        min = j;
+    res[min].push_back (cubes[i]);
+    load[min] += costs[i];
+  }
 }
 
 /*------------------------------------------------------------------------*/
@@ -864,6 +890,58 @@ bool External::traverse_all_frozen_units_as_clauses (ClauseIterator &it) {
   return true;
 }
 
+// All root-level units (not only of frozen variables) and the binary
+// clauses on the extension stack, which are implied by the original formula
+// too and contain the equivalences of substituted variables.
+
+bool External::traverse_all_units_and_equivalences_as_clauses (
+    ClauseIterator &it) {
+  if (internal->unsat)
+    return true;
+
+  vector<int> clause;
+
+  for (auto idx : vars) {
+    const int tmp = fixed (idx);
+    if (!tmp)
+      continue;
+    int unit = tmp < 0 ? -idx : idx;
+    clause.push_back (unit);
+    if (!it.clause (clause))
+      return false;
+    clause.clear ();
+  }
+
+  // See 'traverse_witnesses_forward' for the layout of the stack.
+
+  const auto end = extension.end ();
+  auto i = extension.begin ();
+  if (i != end) {
+    int lit = *i++;
+    do {
+      assert (!lit);
+      while ((lit = *i++)) // Skip witness.
+        ;
+      assert (i != end);
+      i += 3; // Skip identifier.
+      assert (i != end);
+      bool satisfied = false;
+      while (i != end && (lit = *i++)) {
+        const int tmp = fixed (lit);
+        if (tmp > 0)
+          satisfied = true;
+        else if (!tmp)
+          clause.push_back (lit);
+      }
+      if (!satisfied && clause.size () <= 2 && !it.clause (clause))
+        return false;
+      clause.clear ();
+    } while (i != end);
+  }
+
+  return true;
+}
+
 bool External::traverse_all_non_frozen_units_as_witnesses (
     WitnessIterator &it) {
   if (internal->unsat)
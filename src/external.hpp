@@ -43,9 +43,6 @@ using namespace std;
 
 struct Clause;
 struct Internal;
-struct CubesWithStatus;
-
-/*------------------------------------------------------------------------*/
 
 /*------------------------------------------------------------------------*/
 
@@ -97,6 +94,20 @@ struct External {
   void export_learned_unit_clause (int ilit);
   void export_learned_large_clause (const vector<int> &);
 
+  // Buffers to which learned clauses are exported and from which clauses
+  // shared by other solvers are imported (see 'share.cpp').
+
+  struct ExportBuffer {
+    ClauseBuffer *buffer;
+    int max_size, max_glue;
+  };
+
+  vector<ExportBuffer> export_buffers;
+  vector<ClauseBuffer *> import_buffers;
+  vector<int> shared; // Exported or imported external clause.
+
+  void export_shared_clause (const vector<int> &, int glue);
+
   // If there is a listener for fixed assignments.
 
   FixedAssignmentListener *fixed_listener;
@@ -343,7 +354,9 @@ struct External {
   /*----------------------------------------------------------------------*/
 
   int lookahead ();
-  CaDiCaL::CubesWithStatus generate_cubes (int, int);
+  int generate_cubes (int, int, CubeIterator &);
+  void shard_cubes (const vector<vector<int>> &, int shards,
+                    vector<vector<vector<int>>> &);
 
   int fixed (int elit) const; // Implemented in 'internal.hpp'.
 
@@ -358,6 +371,7 @@ struct External {
   // in 'external.cpp' for why we have to distinguish these cases.
 
   bool traverse_all_frozen_units_as_clauses (ClauseIterator &);
+  bool traverse_all_units_and_equivalences_as_clauses (ClauseIterator &);
   bool traverse_all_non_frozen_units_as_witnesses (WitnessIterator &);
   bool traverse_witnesses_backward (WitnessIterator &);
   bool traverse_witnesses_forward (WitnessIterator &);
@@ -757,4 +757,134 @@ void Internal::unmark_gate_clauses (Eliminator &eliminator) {
 
 /*------------------------------------------------------------------------*/
 
+// The cuber uses gates to find variables functionally determined by other
+// variables (see 'lookahead_cube_gates').  Contrary to the functions above
+// this only inspects the clauses in the occurrence lists, which have to
+// contain all irredundant clauses not satisfied on the root level.  Gate
+// clauses are not marked, nor are garbage clauses removed or units found by
+// hyper unary resolution.  If an AND, if-then-else or XOR gate with output
+// 'idx' is found its input variables are pushed on 'inputs'.
+
+void Internal::find_gate_inputs (int idx, vector<int> &inputs) {
+  assert (inputs.empty ());
+  assert (!val (idx));
+  vector<int> lits;
+
+  // AND gate 'pivot = l_1 | ... | l_n' with binary clauses '(pivot | -l_i)'
+  // and base clause '(-pivot | l_1 | ... | l_n)' as in 'find_and_gate'.
+
+  for (const auto &pivot : {idx, -idx}) {
+    vector<int> marked_lits;
+    for (const auto &c : occs (pivot)) {
+      if (!get_clause (c, lits) || lits.size () != 2)
+        continue;
+      const int other = lits[0] == pivot ? lits[1] : lits[0];
+      if (marked (other))
+        continue;
+      mark (other);
+      marked_lits.push_back (other);
+    }
+    if (!marked_lits.empty ())
+      for (const auto &c : occs (-pivot)) {
+        if (!get_clause (c, lits) || lits.size () < 3)
+          continue;
+        bool all_literals_marked = true;
+        for (const auto &lit : lits)
+          if (lit != -pivot && marked (lit) >= 0) {
+            all_literals_marked = false;
+            break;
+          }
+        if (!all_literals_marked)
+          continue;
+        LOG (c, "cuber AND gate base clause for %d", pivot);
+        for (const auto &lit : lits)
+          if (lit != -pivot)
+            inputs.push_back (abs (lit));
+        break;
+      }
+    for (const auto &lit : marked_lits)
+      unmark (lit);
+    if (!inputs.empty ())
+      return;
+  }
+
+  // If-then-else gate with the same clauses as in 'find_if_then_else'.
+
+  const Occs &os = occs (idx);
+  const auto end = os.end ();
+  for (auto i = os.begin (); i != end; i++) {
+    int ai, bi, ci;
+    if (!get_ternary_clause (*i, ai, bi, ci))
+      continue;
+    if (bi == idx)
+      swap (ai, bi);
+    if (ci == idx)
+      swap (ai, ci);
+    if (ai != idx)
+      continue;
+    for (auto j = i + 1; j != end; j++) {
+      int aj, bj, cj;
+      if (!get_ternary_clause (*j, aj, bj, cj))
+        continue;
+      if (bj == idx)
+        swap (aj, bj);
+      if (cj == idx)
+        swap (aj, cj);
+      if (aj != idx)
+        continue;
+      if (abs (bi) == abs (cj))
+        swap (bj, cj);
+      if (abs (ci) == abs (cj))
+        continue;
+      if (bi != -bj)
+        continue;
+      if (!find_ternary_clause (-idx, bi, -ci))
+        continue;
+      if (!find_ternary_clause (-idx, bj, -cj))
+        continue;
+      LOG ("cuber ITE gate %d == (%d ? %d : %d)", idx, -bi, -ci, -cj);
+      inputs.push_back (abs (bi));
+      inputs.push_back (abs (ci));
+      inputs.push_back (abs (cj));
+      return;
+    }
+  }
+
+  // XOR gate with all clauses of one parity as in 'find_xor_gate'.
+
+  for (const auto &d : occs (idx)) {
+    if (!get_clause (d, lits))
+      continue;
+    const int size = lits.size ();
+    const int arity = size - 1;
+    if (size < 3)
+      continue;
+    if (arity > opts.elimxorlim)
+      continue;
+    unsigned needed = (1u << arity) - 1;
+    unsigned signs = 0;
+    do {
+      const unsigned prev = signs;
+      while (parity (++signs))
+        ;
+      for (int j = 0; j < size; j++) {
+        const unsigned bit = 1u << j;
+        if ((prev & bit) != (signs & bit))
+          lits[j] = -lits[j];
+      }
+      if (!find_clause (lits))
+        break;
+    } while (--needed);
+    if (needed)
+      continue;
+    LOG (d, "cuber arity %d XOR gate base clause for %d", arity, idx);
+    for (const auto &lit : lits)
+      if (abs (lit) != idx)
+        inputs.push_back (abs (lit));
+    return;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
 } // namespace CaDiCaL
@@ -16,6 +16,7 @@ Internal::Internal ()
       clause_id (0), original_id (0), reserved_ids (0), 
       conflict_id (0), concluded (false), lrat (false), level (0), vals (0),
       score_inc (1.0), scores (this), conflict (0), ignore (0),
+      background_vivifier (0),
       external_reason (&external_reason_clause), newest_clause (0),
       force_no_backtrack (false), from_propagator (false), ext_clause_forgettable (false),
       tainted_literal (0), notified (0), probe_reason (0), propagated (0),
@@ -48,6 +49,8 @@ Internal::Internal ()
 }
 
 Internal::~Internal () {
+  if (background_vivifier)
+    delete_background_vivifier ();
   delete[](char *) dummy_binary;
   for (const auto &c : clauses)
     delete_clause (c);
@@ -89,7 +92,7 @@ static signed char *ignore_clang_analyze_memory_leak_warning;
 
 void Internal::enlarge_vals (size_t new_vsize) {
   signed char *new_vals;
-  const size_t bytes = 2u * new_vsize;
+  const size_t bytes = 2u * new_vsize + simd_vals_padding;
   new_vals = new signed char[bytes]; // g++-4.8 does not like ... { 0 };
   memset (new_vals, 0, bytes);
   ignore_clang_analyze_memory_leak_warning = new_vals;
@@ -305,6 +308,9 @@ int Internal::cdcl_loop_with_inprocessing () {
       res = decide (); // next decision
   }
 
+  if (background_vivifier)
+    stop_background_vivification ();
+
   if (stable) {
     STOP (stable);
     report (']');
@@ -1034,4 +1040,38 @@ bool Internal::traverse_clauses (ClauseIterator &it) {
   return true;
 }
 
+// Traverse the learned clauses which are not satisfied at the root level
+// and have at most 'max_size' unassigned literals, which includes hyper
+// binary resolvents of probing and lookahead.
+
+bool Internal::traverse_redundant_clauses (ClauseIterator &it,
+                                           int max_size) {
+  if (unsat)
+    return true;
+  vector<int> eclause;
+  for (const auto &c : clauses) {
+    if (c->garbage)
+      continue;
+    if (!c->redundant)
+      continue;
+    bool satisfied = false;
+    for (const auto &ilit : *c) {
+      const int tmp = fixed (ilit);
+      if (tmp > 0) {
+        satisfied = true;
+        break;
+      }
+      if (tmp < 0)
+        continue;
+      const int elit = externalize (ilit);
+      eclause.push_back (elit);
+    }
+    if (!satisfied && (int) eclause.size () <= max_size &&
+        !it.clause (eclause))
+      return false;
+    eclause.clear ();
+  }
+  return true;
+}
+
 } // namespace CaDiCaL
@@ -56,6 +56,7 @@ extern "C" {
 #include "config.hpp"
 #include "contract.hpp"
 #include "cover.hpp"
+#include "cuber.hpp"
 #include "decompose.hpp"
 #include "drattracer.hpp"
 #include "elim.hpp"
@@ -81,6 +82,7 @@ extern "C" {
 #include "options.hpp"
 #include "parse.hpp"
 #include "phases.hpp"
+#include "pool.hpp"
 #include "profile.hpp"
 #include "proof.hpp"
 #include "queue.hpp"
@@ -91,7 +93,9 @@ extern "C" {
 #include "reluctant.hpp"
 #include "resources.hpp"
 #include "score.hpp"
+#include "simd.hpp"
 #include "stats.hpp"
+#include "subsume.hpp"
 #include "terminal.hpp"
 #include "tracer.hpp"
 #include "util.hpp"
@@ -108,17 +112,13 @@ namespace CaDiCaL {
 using namespace std;
 
 struct Coveror;
+struct lookahead_cache;
 struct External;
 struct Walker;
 class Tracer;
 class FileTracer;
 class StatTracer;
 
-struct CubesWithStatus {
-  int status = 0;
-  std::vector<std::vector<int>> cubes;
-};
-
 /*------------------------------------------------------------------------*/
 
 struct Internal {
@@ -218,6 +218,7 @@ struct Internal {
   vector<Watches> wtab;         // table of watches for all literals
   Clause *conflict;             // set in 'propagation', reset in 'analyze'
   Clause *ignore;               // ignored during 'vivify_propagate'
+  BackgroundVivifier *background_vivifier; // see 'vivifypar.cpp'
   Clause *dummy_binary;         // Dummy binary clause for subsumption
   Clause *external_reason;      // used as reason at external propagations
   Clause *newest_clause;        // used in external_propagate
@@ -513,7 +514,9 @@ struct Internal {
   inline void watch_literal (int lit, int blit, Clause *c) {
     assert (lit != blit);
     Watches &ws = watches (lit);
-    ws.push_back (Watch (blit, c));
+    ws.push_back (Watch (lit, blit, c));
+    if (ws.back ().binary ())
+      keep_binary_watches_first (ws);
     LOG (c, "watch %d blit %d in", lit, blit);
   }
 
@@ -559,9 +562,10 @@ struct Internal {
   void mark_pure (int);
 
   // Managing clauses in 'clause.cpp'.  Without explicit 'Clause' argument
-  // these functions work on the global temporary 'clause'.
+  // these functions work on the global temporary 'clause'.  A non-zero 'id'
+  // is used as identifier of the new clause instead of a fresh one.
   //
-  Clause *new_clause (bool red, int glue = 0);
+  Clause *new_clause (bool red, int glue = 0, uint64_t id = 0);
   void promote_clause (Clause *, int new_glue);
   size_t shrink_clause (Clause *, int new_size);
   void minimize_sort_clause ();
@@ -756,6 +760,14 @@ struct Internal {
   void unprotect_reasons ();
   void reduce ();
 
+  // Importing clauses shared by other solvers at restarts and reductions
+  // in 'share.cpp'.
+  //
+  bool importing ();
+  void import_shared_clause (const vector<int> &, int glue);
+  void import_backtrack ();
+  void import_shared_clauses ();
+
   // Garbage collection in 'collect.cpp' called from 'reduce' and during
   // inprocessing and preprocessing.
   //
@@ -800,11 +812,22 @@ struct Internal {
   void strengthen_clause (Clause *, int);
   void subsume_clause (Clause *subsuming, Clause *subsumed);
   int subsume_check (Clause *subsuming, Clause *subsumed);
-  int try_to_subsume_clause (Clause *, vector<Clause *> &shrunken);
+  int try_to_subsume_clause (Clause *, vector<Clause *> &shrunken,
+                             const Subsumer * = 0);
+  int subsume_or_strengthen_clause (Clause *, Clause *, int flipped,
+                                    vector<Clause *> &shrunken);
+  int subsume_commit_result (Subsumer &, Clause *,
+                             vector<Clause *> &shrunken);
   void reset_subsume_bits ();
   bool subsume_round ();
   void subsume (bool update_limits = true);
 
+  // Parallel forward subsumption checking in 'subsumepar.cpp'.
+  //
+  void subsume_check_candidate (SubsumeResult &, Clause *,
+                                signed char *marks);
+  void subsume_check_batch (Subsumer &, int64_t check_limit);
+
   // Covered clause elimination of large clauses.
   //
   void covered_literal_addition (int lit, Coveror &);
@@ -834,6 +857,15 @@ struct Internal {
   void vivify_round (bool redundant_mode, int64_t delta);
   void vivify ();
 
+  // Vivification of learned clauses in a background thread in
+  // 'vivifypar.cpp'.
+  //
+  void start_background_vivification ();
+  void stop_background_vivification ();
+  void delete_background_vivifier ();
+  void vivify_background_results ();
+  void vivify_in_background ();
+
   // Compacting (shrinking internal variable tables) in 'compact.cpp'
   //
   bool compacting ();
@@ -1009,6 +1041,7 @@ struct Internal {
   Clause *find_binary_clause (int, int);
   void find_gate_clauses (Eliminator &, int pivot);
   void unmark_gate_clauses (Eliminator &);
+  void find_gate_inputs (int idx, vector<int> &inputs);
 
   // Bounded variable elimination in 'elim.cpp'.
   //
@@ -1029,6 +1062,14 @@ struct Internal {
   void elim_on_the_fly_self_subsumption (Eliminator &, Clause *, int);
   void try_to_eliminate_variable (Eliminator &, int pivot);
   void increase_elimination_bound ();
+
+  // Counting resolvents of independent candidates in parallel in
+  // 'elimpar.cpp'.
+  //
+  void elim_schedule_batch (Eliminator &);
+  void elim_count_resolvents (ElimCount &, signed char *marks);
+  void elim_count_batch (Eliminator &);
+  int elim_counted_resolvents_are_bounded (Eliminator &, int pivot);
   int elim_round (bool &completed);
   void elim (bool update_limits = true);
 
@@ -1221,7 +1262,26 @@ struct Internal {
 
   //
   int lookahead ();
-  CubesWithStatus generate_cubes (int, int);
+  int generate_cubes (int, int, CubeIterator &);
+  bool lookahead_emit_cube (const std::vector<int> &, CubeIterator &);
+  void lookahead_connect_gate_occs ();
+  void lookahead_cube_gates (std::vector<int> &);
+  void lookahead_cube_candidates (std::vector<int> &);
+  bool lookahead_assign_cube (const std::vector<int> &);
+  void lookahead_touch_literal (lookahead_cache &, int lit);
+  void lookahead_update_cache (lookahead_cache &);
+  void lookahead_connect_occs ();
+  void lookahead_init_budget ();
+  bool lookahead_budget_exhausted ();
+  double lookahead_reduction (size_t before);
+  double lookahead_cube_probe (int);
+  bool lookahead_double (const std::vector<int> &, int lit);
+  int lookahead_cube_probing (const std::vector<int> &, std::vector<int> &,
+                              lookahead_cache &);
+  int64_t lookahead_free_variables ();
+  int64_t lookahead_free_variables_after (int lit);
+  void lookahead_cube_costs (const std::vector<std::vector<int>> &,
+                             std::vector<double> &);
   int most_occurring_literal ();
   int lookahead_probing ();
   int lookahead_next_probe ();
@@ -1362,6 +1422,7 @@ struct Internal {
   // Export and traverse all irredundant (non-unit) clauses.
   //
   bool traverse_clauses (ClauseIterator &);
+  bool traverse_redundant_clauses (ClauseIterator &, int max_size);
 
   // Export and traverse all irredundant (non-unit) clauses.
   //
@@ -35,6 +35,12 @@ struct Limit {
   //
   int64_t elimbound;
 
+  struct {
+    double time;          // wall clock time limit if positive
+    int64_t propagations; // propagation limit if positive
+    bool exhausted;       // one of the limits was hit
+  } cube;
+
   struct {
     int check;  // countdown to next terminator call
     int forced; // forced termination for testing
@@ -46,7 +52,7 @@ struct Limit {
 struct Last {
   struct {
     int64_t propagations;
-  } transred, vivify;
+  } transred, vivify, vivifybg;
   struct {
     int64_t fixed, subsumephases, marked;
   } elim;
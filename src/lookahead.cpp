@@ -401,17 +401,581 @@ int Internal::lookahead_probing () {
   return res;
 }
 
-CubesWithStatus Internal::generate_cubes (int depth, int min_depth) {
+// Hand out a cube to the iterator after mapping it to external literals.
+
+bool Internal::lookahead_emit_cube (const std::vector<int> &cube,
+                                    CubeIterator &it) {
+  assert (non_tautological_cube (cube));
+  stats.cube.cubes++;
+  std::vector<int> ecube;
+  ecube.reserve (cube.size ());
+  for (const auto &ilit : cube) {
+    const int elit = externalize (ilit);
+    LOG ("lookahead internal %d external %d", ilit, elit);
+    ecube.push_back (elit);
+  }
+  return it.cube (ecube);
+}
+
+// Gates are found with 'find_gate_inputs' on full occurrence lists of the
+// irredundant clauses not satisfied on the root level.
+
+void Internal::lookahead_connect_gate_occs () {
+  init_occs ();
+  for (const auto &c : clauses) {
+    if (c->garbage || c->redundant)
+      continue;
+    bool satisfied = false;
+    for (const auto &lit : *c)
+      if (val (lit) > 0)
+        satisfied = true;
+    if (satisfied)
+      continue;
+    for (const auto &lit : *c)
+      if (!val (lit))
+        occs (lit).push_back (c);
+  }
+}
+
+// Only variables in binary clauses miss for instance XOR chains without
+// any binary clause.  Thus with 'cubegates' we also determine AND,
+// if-then-else and XOR gates on the root level.  A gate is only accepted
+// if its output is neither the output nor an input of an already accepted
+// gate, which keeps the accepted definitions acyclic.  Variables are tried
+// in increasing index order, since in typical (Tseitin) encodings inputs
+// have smaller indices than outputs, such that chains of gates are kept.
+// Outputs are functionally determined by the remaining variables and thus
+// assigned by propagation as soon as those are all assigned.  We set
+// 'fanout[idx]' to '-1' for outputs and otherwise to the number of gates
+// the variable is an input of.
+
+void Internal::lookahead_cube_gates (std::vector<int> &fanout) {
+  assert (!level);
+  fanout.assign (max_var + 1, 0);
+  lookahead_connect_gate_occs ();
+  std::vector<int> inputs;
+  int64_t found = 0;
+  for (int idx = 1; idx <= max_var; idx++) {
+    if (!active (idx) || val (idx) || fanout[idx])
+      continue;
+    inputs.clear ();
+    find_gate_inputs (idx, inputs);
+    if (inputs.empty ())
+      continue;
+    fanout[idx] = -1;
+    for (const auto &input : inputs)
+      if (fanout[input] >= 0)
+        fanout[input]++;
+    found++;
+  }
+  reset_occs ();
+  stats.cube.gates += found;
+  VERBOSE (2, "found %" PRId64 " gates for splitting", found);
+}
+
+// The candidate split variables are variables with a literal which implies
+// at least one other literal through a binary clause.  They are determined
+// once on the root level and ordered by the product of the number of binary
+// implications of both literals (and their sum for ties), the same product
+// rule as used in lookahead for the actual scores below.  With 'cubegates'
+// gate outputs are no candidates, while gate inputs are, and each gate an
+// input feeds into counts as implication for both of its literals.
+
+void Internal::lookahead_cube_candidates (std::vector<int> &candidates) {
+  assert (!level);
+  std::vector<int> fanout;
+  if (opts.cubegates)
+    lookahead_cube_gates (fanout);
+  init_noccs ();
+  for (const auto &c : clauses) {
+    int a, b;
+    if (!is_binary_clause (c, a, b))
+      continue;
+    noccs (a)++;
+    noccs (b)++;
+  }
+  for (int idx = 1; idx <= max_var; idx++) {
+    if (!active (idx))
+      continue;
+    if (!fanout.empty ()) {
+      if (fanout[idx] < 0)
+        continue;
+      noccs (idx) += fanout[idx];
+      noccs (-idx) += fanout[idx];
+    }
+    if (noccs (idx) || noccs (-idx))
+      candidates.push_back (idx);
+  }
+  auto rank = [this] (int idx) {
+    const int64_t pos = noccs (idx), neg = noccs (-idx);
+    return 1024 * pos * neg + pos + neg;
+  };
+  stable_sort (candidates.begin (), candidates.end (),
+               [&rank] (int a, int b) { return rank (a) > rank (b); });
+  reset_noccs ();
+  LOG ("found %zu lookahead candidates", candidates.size ());
+}
+
+// Large irredundant clauses are connected through full occurrence lists
+// for the weighted binary clause heuristic.  The clause database does not
+// change while generating cubes, thus this is only done once.
+
+void Internal::lookahead_connect_occs () {
+  init_occs ();
+  for (const auto &c : clauses)
+    if (!c->garbage && !c->redundant && c->size > 2)
+      for (const auto &lit : *c)
+        occs (lit).push_back (c);
+}
+
+// Assign the literals of the cube as decisions, one per decision level,
+// starting at the first level not already on the trail.  Literals already
+// implied get a pseudo decision level.  Returns false if the cube is
+// falsified, in which case the trail is kept consistent up to the last
+// decision level which did not produce a conflict.
+
+bool Internal::lookahead_assign_cube (const std::vector<int> &cube) {
+  while ((size_t) level < cube.size ()) {
+    const int lit = cube[level];
+    const signed char tmp = val (lit);
+    if (tmp < 0) {
+      LOG ("cube literal %d falsified", lit);
+      return false;
+    }
+    if (tmp > 0) {
+      new_trail_level (0);
+      continue;
+    }
+    search_assume_decision (lit);
+    if (!propagate ()) {
+      LOG ("propagating cube literal %d yields conflict", lit);
+      backtrack (level - 1);
+      conflict = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Lookahead scores (number of implied literals) of the candidates are
+// cached across the nodes of the cube tree.  Along with the scores we keep
+// the trail (above the root level) under which they were computed.  Moving
+// to another cube only changes the assignment of the literals after the
+// common prefix of that trail and the current one.  The scores of these
+// variables and of the variables in binary clauses with those literals
+// change most directly.  These are marked as touched and their scores are
+// invalidated, while all others keep their score as an estimate (neither
+// implications through larger clauses nor transitive implications are
+// followed).  Thus touching a literal is linear in the number of its
+// watches and does not depend on the size of the watched clauses.  This
+// avoids probing all candidates again for every node of the cube tree, as
+// the nodes of a sub-tree differ only by a few literals.  Occurrence counts
+// for the fallback heuristic and the candidates are computed only once at
+// the root anyhow.
+
+struct lookahead_cache {
+  std::vector<double> scores;     // Indexed by 'vlit' and '-1' if invalid.
+  std::vector<int> trail;         // Trail under which scores are valid.
+  std::vector<signed char> marks; // Marks touched variables.
+  std::vector<int> touched;       // Variables to probe again.
+  void touch (int idx) {
+    if (marks[idx])
+      return;
+    marks[idx] = true;
+    touched.push_back (idx);
+  }
+};
+
+void Internal::lookahead_touch_literal (lookahead_cache &cache, int lit) {
+  cache.touch (vidx (lit));
+  for (const auto &sign : {-1, 1})
+    for (const auto &w : watches (sign * lit))
+      if (w.binary () && !w.clause->garbage)
+        cache.touch (vidx (w.blit));
+}
+
+void Internal::lookahead_update_cache (lookahead_cache &cache) {
+  if (cache.scores.empty ()) {
+    cache.scores.resize (2 * (max_var + 1), -1);
+    cache.marks.resize (max_var + 1, false);
+  }
+  if (!opts.cubecache) {
+    fill (cache.scores.begin (), cache.scores.end (), -1);
+    return;
+  }
+  const size_t root = level ? control[1].trail : trail.size ();
+  const size_t size = trail.size () - root;
+  size_t common = 0;
+  while (common < size && common < cache.trail.size () &&
+         cache.trail[common] == trail[root + common])
+    common++;
+  for (size_t i = common; i < cache.trail.size (); i++)
+    lookahead_touch_literal (cache, cache.trail[i]);
+  cache.trail.resize (common);
+  for (size_t i = root + common; i < trail.size (); i++) {
+    const int lit = trail[i];
+    lookahead_touch_literal (cache, lit);
+    cache.trail.push_back (lit);
+  }
+  for (const auto &idx : cache.touched) {
+    cache.scores[vlit (idx)] = cache.scores[vlit (-idx)] = -1;
+    cache.marks[idx] = false;
+  }
+  cache.touched.clear ();
+}
+
+// The weighted binary clause heuristic of 'march' measures the reduction
+// of the formula by a lookahead as the number of newly produced binary
+// clauses, where clauses reduced to a larger size count with weights
+// decreasing by a factor of five per additional literal.  Each reduced
+// clause is only counted for the first of its literals falsified by the
+// lookahead (the one with the smallest trail position).
+
+double Internal::lookahead_reduction (size_t before) {
+  static const double weights[] = {1, 0.2, 0.04, 0.008, 0.0016};
+  const size_t max_weight = sizeof weights / sizeof *weights;
+  double res = 0;
+  for (size_t i = before; i < trail.size (); i++) {
+    const int lit = trail[i];
+    for (const auto &c : occs (-lit)) {
+      size_t unassigned = 0;
+      bool skip = false;
+      for (const auto &other : *c) {
+        const signed char tmp = val (other);
+        if (tmp > 0 || (tmp < 0 && other != -lit &&
+                        var (other).level == level &&
+                        (size_t) var (other).trail < i)) {
+          skip = true;
+          break;
+        }
+        unassigned += !tmp;
+      }
+      if (skip || unassigned < 2 || unassigned - 2 >= max_weight)
+        continue;
+      res += weights[unassigned - 2];
+    }
+  }
+  return res;
+}
+
+// Decide and propagate the probe on top of the cube and return its score,
+// which is either the reduction as above ('cubewbh') or the number of
+// implied literals, or '-1' if the probe failed.
+
+double Internal::lookahead_cube_probe (int probe) {
+  stats.cube.probes++;
+  const size_t before = trail.size ();
+  search_assume_decision (probe);
+  double res = -1;
+  if (propagate ()) {
+    if (opts.cubewbh)
+      res = lookahead_reduction (before);
+    else
+      res = trail.size () - before;
+  } else
+    conflict = 0;
+  backtrack (level - 1);
+  return res;
+}
+
+// Double lookahead checks whether the literal fails on the second level,
+// i.e., after deciding the literal, second level probes are decided and
+// propagated, and the negation of a failed second level probe is assigned
+// (on its own decision level).  If this yields a conflict then the literal
+// failed.  We only try the first 'cubedouble' candidates.
+
+bool Internal::lookahead_double (const std::vector<int> &candidates,
+                                 int lit) {
+  stats.cube.doubles++;
+  const int base = level;
+  search_assume_decision (lit);
+  bool failed = !propagate ();
+  int probes = 0;
+  for (const auto &idx : candidates) {
+    if (failed || probes >= opts.cubedouble)
+      break;
+    for (const auto &probe : {idx, -idx}) {
+      if (!active (probe) || val (probe))
+        continue;
+      probes++;
+      search_assume_decision (probe);
+      const bool ok = propagate ();
+      backtrack (level - 1);
+      if (ok)
+        continue;
+      conflict = 0;
+      LOG ("double lookahead probe %d failed under %d", probe, lit);
+      search_assume_decision (-probe);
+      if (!propagate ())
+        failed = true;
+      break;
+    }
+  }
+  if (failed) {
+    LOG ("double lookahead literal %d failed", lit);
+    stats.cube.dfailed++;
+    conflict = 0;
+  }
+  backtrack (base);
+  return failed;
+}
+
+// Lookahead under the current cube.  Both literals of every unassigned
+// candidate variable are decided and propagated on top of the cube and the
+// variable with the largest product of the scores of its two literals
+// (the product rule of 'march' and 'kcnfs', with their sum for ties) is
+// selected for splitting.  Ties are broken in favor of more recently
+// bumped variables.  The literal with the larger score is returned.
+//
+// Variables with cached scores for both literals are only probed again if
+// their cached product is still larger than the best fresh product, in the
+// order of their cached product, such that the selected variable always
+// has fresh scores.  If a candidate literal fails under the cube its
+// negation is implied by the cube.  It is added to the cube (on its own
+// decision level, without counting as split) and lookahead starts over.
+// The same happens if double lookahead ('cubedouble') shows that a literal
+// of the selected variable fails.  Returns 'INT_MIN' if the cube turns out
+// to be falsified this way.
+
+int Internal::lookahead_cube_probing (const std::vector<int> &candidates,
+                                      std::vector<int> &cube,
+                                      lookahead_cache &cache) {
+  int res = 0;
+  stats.cube.nodes++;
+  std::vector<int> cached;
+  auto product = [this, &cache] (int idx) {
+    const double pos = cache.scores[vlit (idx)];
+    const double neg = cache.scores[vlit (-idx)];
+    return 1024 * pos * neg + pos + neg;
+  };
+  for (bool restart = true; restart;) {
+    restart = false;
+    lookahead_update_cache (cache);
+    double max_score = -1;
+    res = 0;
+    cached.clear ();
+    for (size_t round = 0; !restart && round < 2; round++) {
+      if (round)
+        stable_sort (
+            cached.begin (), cached.end (),
+            [&product] (int a, int b) { return product (a) > product (b); });
+      const std::vector<int> &probes = round ? cached : candidates;
+      for (size_t i = 0; !restart && i < probes.size (); i++) {
+        const int idx = probes[i];
+        if (!active (idx) || val (idx))
+          continue;
+        if (!round && cache.scores[vlit (idx)] >= 0 &&
+            cache.scores[vlit (-idx)] >= 0) {
+          cached.push_back (idx);
+          continue;
+        }
+        if (round && product (idx) < max_score) {
+          stats.cube.cached += probes.size () - i;
+          break;
+        }
+        if (lookahead_budget_exhausted ())
+          break;
+        for (const auto &probe : {idx, -idx}) {
+          double &score = cache.scores[vlit (probe)];
+          if (!round && score >= 0)
+            continue;
+          score = lookahead_cube_probe (probe);
+          if (score >= 0)
+            continue;
+          LOG ("lookahead candidate %d failed under cube", probe);
+          cube.push_back (-probe);
+          if (!lookahead_assign_cube (cube))
+            return INT_MIN;
+          restart = true;
+          break;
+        }
+        if (restart)
+          break;
+        const double score = product (idx);
+        if (score < max_score)
+          continue;
+        if (score == max_score && bumped (idx) <= bumped (res))
+          continue;
+        max_score = score;
+        res = idx;
+      }
+    }
+    if (restart || !res)
+      continue;
+    if (cache.scores[vlit (-res)] > cache.scores[vlit (res)])
+      res = -res;
+    LOG ("lookahead literal %d with score %g", res, max_score);
+    if (!opts.cubedouble)
+      continue;
+    for (const auto &lit : {res, -res}) {
+      if (!lookahead_double (candidates, lit))
+        continue;
+      cube.push_back (-lit);
+      if (!lookahead_assign_cube (cube))
+        return INT_MIN;
+      restart = true;
+      break;
+    }
+  }
+  return res;
+}
+
+// Number of active variables not assigned by the current cube, which is
+// our estimate of the hardness of the sub-problem under the cube.
+
+int64_t Internal::lookahead_free_variables () {
+  const size_t root = level ? control[1].trail : trail.size ();
+  return active () - (int64_t) (trail.size () - root);
+}
+
+// Same after additionally deciding and propagating 'lit' (or '0' if
+// this yields a conflict, as then there is nothing left to solve).
+
+int64_t Internal::lookahead_free_variables_after (int lit) {
+  assert (!val (lit));
+  search_assume_decision (lit);
+  int64_t res = 0;
+  if (propagate ())
+    res = lookahead_free_variables ();
+  else
+    conflict = 0;
+  backtrack (level - 1);
+  return res;
+}
+
+// Estimated difficulty of the given cubes (of internal literals) used for
+// sharding them.  As in adaptive cube generation (see 'cubetargetexp') the
+// difficulty is exponential in the number of free variables left after
+// assigning and propagating the cube and normalized such that the hardest
+// cube has cost one.  Cubes falsified by propagation have cost zero.
+
+void Internal::lookahead_cube_costs (
+    const std::vector<std::vector<int>> &cubes, std::vector<double> &costs) {
+  costs.assign (cubes.size (), 0);
+  if (unsat)
+    return;
+  if (level)
+    backtrack ();
+  if (!propagate ()) {
+    learn_empty_clause ();
+    return;
+  }
+  if (external_prop)
+    private_steps = true;
+
+  std::vector<int64_t> free (cubes.size (), -1);
+  int64_t max_free = 0;
+  for (size_t i = 0; i < cubes.size (); i++) {
+    bool falsified = false;
+    for (const auto &lit : cubes[i]) {
+      const signed char tmp = val (lit);
+      if (tmp > 0 || !active (lit))
+        continue;
+      if (tmp < 0) {
+        falsified = true;
+        break;
+      }
+      search_assume_decision (lit);
+      if (!propagate ()) {
+        conflict = 0;
+        falsified = true;
+        break;
+      }
+    }
+    if (!falsified)
+      max_free = std::max (max_free, free[i] = lookahead_free_variables ());
+    if (level)
+      backtrack ();
+  }
+
+  if (external_prop) {
+    private_steps = false;
+    notify_assignments ();
+  }
+
+  const double e = opts.cubetargetexp;
+  for (size_t i = 0; i < cubes.size (); i++)
+    if (free[i] >= 0)
+      costs[i] = max_free ? pow ((double) free[i] / max_free, e) : 1;
+}
+
+// Budgets for generating cubes in wall clock time ('cubetime') and
+// propagations ('cubeprops').  Hitting a budget has the same effect as
+// termination, i.e., cubes are not split by lookahead anymore.
+
+void Internal::lookahead_init_budget () {
+  lim.cube.exhausted = false;
+  if (opts.cubetime)
+    lim.cube.time = absolute_real_time () + opts.cubetime;
+  else
+    lim.cube.time = 0;
+  if (opts.cubeprops)
+    lim.cube.propagations = stats.propagations.search + opts.cubeprops;
+  else
+    lim.cube.propagations = 0;
+}
+
+bool Internal::lookahead_budget_exhausted () {
+  if (lim.cube.exhausted)
+    return true;
+  if (lim.cube.propagations &&
+      stats.propagations.search >= lim.cube.propagations) {
+    VERBOSE (2, "cube propagation budget of %d exhausted", opts.cubeprops);
+    lim.cube.exhausted = true;
+  } else if (lim.cube.time && absolute_real_time () >= lim.cube.time) {
+    VERBOSE (2, "cube time budget of %d seconds exhausted", opts.cubetime);
+    lim.cube.exhausted = true;
+  } else if (terminating_asked ())
+    lim.cube.exhausted = true;
+  return lim.cube.exhausted;
+}
+
+// Cubes are generated depth-first.  The literals of the current cube are
+// assigned as decisions (one per decision level) and lookahead for the
+// next split literal is performed under the cube.  A cube and the next
+// one share the trail up to their common prefix, thus moving on only
+// backtracks to that level and assigns the remaining literals instead of
+// starting from scratch.  Pending cubes are kept on a stack of split
+// literals together with the size of the cube prefix they extend, which
+// makes the memory needed linear in the depth.
+//
+// Cubes are handed out as soon as they are final, i.e., either they reach
+// the requested depth or lookahead does not find a literal to split on.
+// Cubes falsified by propagation are dropped.  The iterator can abort
+// generation by returning 'false'.
+//
+// Generation is anytime.  If termination is requested or a budget is
+// exhausted ('cubetime', 'cubeprops') the remaining cubes are not split
+// by lookahead anymore but emitted as they are, or, if they are below
+// 'min_depth', split with the cheap occurrence heuristic.  With 'cubemax'
+// a cube is not split if that would exceed that number of cubes.  In all
+// cases the generated cubes still partition the search space.
+//
+// With 'cubetarget' set the depth is adaptive (and 'depth' only an upper
+// bound).  Every cube gets a budget of cubes, initially the target for the
+// root.  Splitting distributes the budget over the two children relative
+// to their number of free variables after propagation raised to the power
+// 'cubetargetexp', and a cube with a budget below two is not split
+// further.  Thus easy branches stop early and hard ones are split deeper,
+// which gives a more balanced cube set of roughly the target size.  The
+// budget of falsified cubes is passed on to the next cube.
+
+struct cube_split {
+  size_t size;   // Size of the cube prefix to extend.
+  int depth;     // Number of split literals after extending.
+  int lit;
+  double budget; // Number of cubes to generate from this one (adaptive).
+};
+
+int Internal::generate_cubes (int depth, int min_depth, CubeIterator &it) {
   if (!active () || depth == 0) {
-    CubesWithStatus cubes;
-    cubes.status = 0;
-    cubes.cubes.push_back (std::vector<int> ());
-    return cubes;
+    it.cube (std::vector<int> ());
+    return 0;
   }
 
   lookingahead = true;
   START (lookahead);
-  MSG ("Generating cubes of depth %i", depth);
+  LOG ("generating cubes of depth %i", depth);
 
   // presimplify required due to assumptions
 
@@ -424,97 +988,140 @@ CubesWithStatus Internal::generate_cubes (int depth, int min_depth) {
   if (res != 0)
     res = solve (true);
   if (res != 0) {
-    MSG ("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = res;
+    LOG ("solved during preprocessing");
     lookingahead = false;
     STOP (lookahead);
-    return cubes;
+    return res;
   }
 
   reset_limits ();
-  MSG ("generate cubes with %zu assumptions\n", assumptions.size ());
+  lookahead_init_budget ();
+  LOG ("generate cubes with %zu assumptions", assumptions.size ());
+
+  if (level)
+    backtrack ();
+  if (external_prop)
+    private_steps = true;
+
+  // Root level simplification as in 'lookahead_probing' but only once.
+
+  if (!lookahead_budget_exhausted ()) {
+    decompose ();
+    if (ternary ())
+      decompose ();
+    mark_duplicated_binary_clauses_as_garbage ();
+  }
 
   assert (ntab.empty ());
-  std::vector<int> current_assumptions{assumptions};
-  std::vector<std::vector<int>> cubes{{assumptions}};
   auto loccs{lookahead_populate_locc ()};
-  LOG ("loccs populated\n");
+  std::vector<int> candidates;
+  if (!unsat)
+    lookahead_cube_candidates (candidates);
   assert (ntab.empty ());
+  if (opts.cubewbh)
+    lookahead_connect_occs ();
+
+  const int64_t cubes_before = stats.cube.cubes;
+  const int64_t nodes_before = stats.cube.nodes;
+  const int64_t cheap_before = stats.cube.cheap;
+  std::vector<int> cube{assumptions};
+  std::vector<cube_split> pending;
+  lookahead_cache cache;
+  bool aborted = false, root = true;
+  int cube_depth = 0;
+
+  const bool adaptive = opts.cubetarget;
+  double budget = opts.cubetarget, carry = 0;
+
+  while (!unsat && !aborted) {
+    if (!root) {
+      if (pending.empty ())
+        break;
+      const cube_split split = pending.back ();
+      pending.pop_back ();
+      cube.resize (split.size);
+      cube.push_back (split.lit);
+      cube_depth = split.depth;
+      budget = split.budget + carry;
+      carry = 0;
+      if ((size_t) level >= cube.size ())
+        backtrack (cube.size () - 1);
+    }
+    root = false;
 
-  for (int i = 0; i < depth; ++i) {
-    LOG ("Probing at depth %i, currently %zu have been generated", i,
-         cubes.size ());
-    std::vector<std::vector<int>> cubes2{std::move (cubes)};
-    cubes.clear ();
-
-    for (size_t j = 0; j < cubes2.size (); ++j) {
-      assert (ntab.empty ());
-      assert (!unsat);
-      reset_assumptions ();
-      for (auto lit : cubes2[j])
-        assume (lit);
-      restore_clauses ();
-      propagate ();
-      // preprocess_round(0); //uncomment maybe
-
-      if (unsat) {
-        LOG ("current cube is unsat; skipping");
-        unsat = false;
-        continue;
-      }
-
-      int res = terminating_asked () ? lookahead_locc (loccs)
-                                     : lookahead_probing ();
-      if (unsat) {
-        LOG ("current cube is unsat; skipping");
-        unsat = false;
-        continue;
-      }
+    if (!lookahead_assign_cube (cube)) {
+      LOG ("current cube is unsat; skipping");
+      carry = budget;
+      continue;
+    }
 
-      if (res == 0) {
-        LOG ("no lit to split %i", res);
-        cubes.push_back (cubes2[j]);
-        continue;
-      }
+    const bool terminating = lookahead_budget_exhausted ();
+    const bool easy = adaptive && budget < 2;
+    const size_t leaves = stats.cube.cubes - cubes_before + pending.size ();
+    const bool full = opts.cubemax && leaves + 2 > (size_t) opts.cubemax;
+    if (cube_depth == depth || full ||
+        ((terminating || easy) && cube_depth >= min_depth)) {
+      aborted = !lookahead_emit_cube (cube, it);
+      continue;
+    }
 
-      assert (res != 0);
-      LOG ("splitting on lit %i", res);
-      std::vector<int> cube1{cubes2[j]};
-      cube1.push_back (res);
-      std::vector<int> cube2{std::move (cubes2[j])};
-      cube2.push_back (-res);
-      cubes.push_back (cube1);
-      cubes.push_back (cube2);
+    int lit = 0;
+    if (!terminating)
+      lit = lookahead_cube_probing (candidates, cube, cache);
+    if (lit == INT_MIN) {
+      LOG ("current cube is unsat after lookahead; skipping");
+      carry = budget;
+      continue;
+    }
+    if (!lit && (lit = lookahead_locc (loccs)))
+      stats.cube.cheap++;
+    if (!lit) {
+      LOG ("no lit to split");
+      aborted = !lookahead_emit_cube (cube, it);
+      continue;
     }
 
-    if (terminating_asked () && i >= min_depth)
-      break;
+    LOG ("splitting on lit %i", lit);
+    double pos_budget = 0, neg_budget = 0;
+    if (adaptive) {
+      const double pos = lookahead_free_variables_after (lit);
+      const double neg = lookahead_free_variables_after (-lit);
+      const double e = opts.cubetargetexp, max = std::max (pos, neg);
+      const double pp = max ? pow (pos / max, e) : 1;
+      const double nn = max ? pow (neg / max, e) : 1;
+      pos_budget = budget * pp / (pp + nn);
+      neg_budget = budget - pos_budget;
+      LOG ("split budget %.1f into %.1f and %.1f", budget, pos_budget,
+           neg_budget);
+    }
+    pending.push_back ({cube.size (), cube_depth + 1, -lit, neg_budget});
+    pending.push_back ({cube.size (), cube_depth + 1, lit, pos_budget});
   }
 
-  assert (std::for_each (
-      std::begin (cubes), std::end (cubes),
-      [] (std::vector<int> cube) { return non_tautological_cube (cube); }));
-  reset_assumptions ();
-
-  for (auto lit : current_assumptions)
-    assume (lit);
+  if (level)
+    backtrack ();
+  if (opts.cubewbh)
+    reset_occs ();
+  VERBOSE (2,
+           "generated %" PRId64 " cubes with %" PRId64
+           " lookahead and %" PRId64 " cheap splits%s",
+           stats.cube.cubes - cubes_before, stats.cube.nodes - nodes_before,
+           stats.cube.cheap - cheap_before,
+           lim.cube.exhausted ? " (budget exhausted)" : "");
+  if (external_prop) {
+    private_steps = false;
+    notify_assignments ();
+  }
 
   STOP (lookahead);
   lookingahead = false;
 
   if (unsat) {
-    LOG ("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = 20;
-    return cubes;
+    LOG ("solved during preprocessing");
+    return 20;
   }
 
-  CubesWithStatus rcubes;
-  rcubes.status = 0;
-  rcubes.cubes = cubes;
-
-  return rcubes;
+  return 0;
 }
 
 } // namespace CaDiCaL
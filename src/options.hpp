@@ -60,6 +60,18 @@ OPTION( covermaxeff,     1e8,  0,2e9,1,0,1, "maximum cover efficiency") \
 OPTION( coverminclslim,    2,  2,2e9,0,0,1, "minimum clause size") \
 OPTION( covermineff,     1e6,  0,2e9,1,0,1, "minimum cover efficiency") \
 OPTION( coverreleff,       4,  1,1e5,1,0,1, "relative efficiency per mille") \
+OPTION( cubecache,         1,  0,  1,0,0,1, "cache lookahead scores in cube tree") \
+OPTION( cubedouble,       16,  0,1e4,0,0,1, "double lookahead probes (0=disable)") \
+OPTION( cubegates,         1,  0,  1,0,0,1, "gate-aware selection of split variables") \
+OPTION( cubelearned,       2,  0,1e9,0,0,1, "size of learned clauses exported with cubes") \
+OPTION( cubemax,           0,  0,2e9,0,0,1, "maximum number of cubes (0=unlimited)") \
+OPTION( cubeprops,         0,  0,2e9,0,0,1, "cube propagation budget (0=unlimited)") \
+OPTION( cubetarget,        0,  0,1e9,0,0,1, "adaptive depth for target cubes (0=uniform)") \
+OPTION( cubetargetexp,     8,  1, 64,0,0,1, "exponent of free variables in budget split") \
+OPTION( cubethreads,       0,  0,1e3,0,0,1, "parallel cube generation threads") \
+OPTION( cubethreadsdepth,  4,  1, 32,0,0,1, "sequential cube frontier depth") \
+OPTION( cubetime,          0,  0,2e9,0,0,1, "cube time budget in seconds (0=unlimited)") \
+OPTION( cubewbh,           1,  0,  1,0,0,1, "weighted binary clause heuristic") \
 OPTION( decompose,         1,  0,  1,0,1,1, "decompose BIG in SCCs and ELS") \
 OPTION( decomposerounds,   2,  1, 16,1,0,1, "number of decompose rounds") \
 OPTION( deduplicate,       1,  0,  1,0,1,1, "remove duplicated binaries") \
@@ -69,9 +81,11 @@ OPTION( elim,              1,  0,  1,0,1,1, "bounded variable elimination") \
 OPTION( elimands,          1,  0,  1,0,0,1, "find AND gates") \
 OPTION( elimaxeff,       2e9,  0,2e9,1,0,1, "maximum elimination efficiency") \
 OPTION( elimbackward,      1,  0,  1,0,0,1, "eager backward subsumption") \
+OPTION( elimbatch,       1e3,  1,1e6,0,0,1, "candidates per parallel batch") \
 OPTION( elimboundmax,     16, -1,2e6,1,0,1, "maximum elimination bound") \
 OPTION( elimboundmin,      0, -1,2e6,0,0,1, "minimum elimination bound") \
 OPTION( elimclslim,      1e2,  2,2e9,2,0,1, "resolvent size limit") \
+OPTION( elimcountthreads,  0,  0,1e3,0,0,1, "threads counting resolvents") \
 OPTION( elimequivs,        1,  0,  1,0,0,1, "find equivalence gates") \
 OPTION( elimineff,       1e7,  0,2e9,1,0,1, "minimum elimination efficiency") \
 OPTION( elimint,         2e3,  1,2e9,0,0,1, "elimination interval") \
@@ -154,6 +168,8 @@ OPTION( shuffle,           0,  0,  1,0,0,1, "shuffle variables") \
 OPTION( shufflequeue,      1,  0,  1,0,0,1, "shuffle variable queue") \
 OPTION( shufflerandom,     0,  0,  1,0,0,1, "not reverse but random") \
 OPTION( shufflescores,     1,  0,  1,0,0,1, "shuffle variable scores") \
+OPTION( simd,              0,  0,  1,0,0,1, "vectorized watch replacement search") \
+OPTION( simdsize,         32,  3,2e9,0,0,1, "minimum clause size for 'simd'") \
 OPTION( stabilize,         1,  0,  1,0,0,1, "enable stabilizing phases") \
 OPTION( stabilizefactor, 200,101,2e9,0,0,1, "phase increase in percent") \
 OPTION( stabilizeint,    1e3,  1,2e9,0,0,1, "stabilizing interval") \
@@ -161,6 +177,7 @@ OPTION( stabilizemaxint, 2e9,  1,2e9,0,0,1, "maximum stabilizing phase") \
 OPTION( stabilizeonly,     0,  0,  1,0,0,1, "only stabilizing phases") \
 OPTION( stats,             0,  0,  1,0,0,1, "print all statistics at the end of the run") \
 OPTION( subsume,           1,  0,  1,0,1,1, "enable clause subsumption") \
+OPTION( subsumebatch,    1e3,  1,1e6,0,0,1, "candidates per parallel batch") \
 OPTION( subsumebinlim,   1e4,  0,2e9,1,0,1, "watch list length limit") \
 OPTION( subsumeclslim,   1e2,  0,2e9,2,0,1, "clause length limit") \
 OPTION( subsumeint,      1e4,  1,2e9,0,0,1, "subsume interval") \
@@ -170,6 +187,7 @@ OPTION( subsumemineff,   1e6,  0,2e9,1,0,1, "minimum subsuming efficiency") \
 OPTION( subsumeocclim,   1e2,  0,2e9,1,0,1, "watch list length limit") \
 OPTION( subsumereleff,   1e3,  1,1e5,1,0,1, "relative efficiency per mille") \
 OPTION( subsumestr,        1,  0,  1,0,0,1, "strengthen during subsume") \
+OPTION( subsumethreads,    0,  0,1e3,0,0,1, "parallel subsumption threads") \
 OPTION( target,            1,  0,  2,0,0,1, "target phases (1=stable only)") \
 OPTION( terminateint,     10,  0,1e4,0,0,1, "termination check interval") \
 OPTION( ternary,           1,  0,  1,0,1,1, "hyper ternary resolution") \
@@ -186,6 +204,7 @@ OPTION( transredreleff,  1e2,  1,1e5,1,0,1, "relative efficiency per mille") \
 QUTOPT( verbose,           0,  0,  3,0,0,0, "more verbose messages") \
 OPTION( veripb,            0,  0,  4,0,0,1, "odd=checkdeletions, > 2=drat") \
 OPTION( vivify,            1,  0,  1,0,1,1, "vivification") \
+OPTION( vivifybackground,  0,  0,  1,0,0,1, "vivify learned clauses in background") \
 OPTION( vivifyinst,        1,  0,  1,0,0,1, "instantiate last literal when vivify") \
 OPTION( vivifymaxeff,    2e7,  0,2e9,1,0,1, "maximum efficiency") \
 OPTION( vivifymineff,    2e4,  0,2e9,1,0,1, "minimum efficiency") \
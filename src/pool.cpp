@@ -0,0 +1,110 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+size_t capped_threads (size_t requested) {
+  const size_t cores = std::thread::hardware_concurrency ();
+  if (cores && requested > cores)
+    requested = cores;
+  return requested;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Workers wait for the job counter to change, run the current job and the
+// last one to finish wakes up the caller of 'run'.  Since 'run' waits for
+// all workers, each of them sees every job exactly once.
+
+struct WorkerPool::State {
+
+  std::mutex mutex;
+  std::condition_variable wakeup, finished;
+  vector<std::thread> threads;
+
+  const std::function<void (size_t)> *job;
+  uint64_t jobs;  // Number of jobs started.
+  size_t running; // Workers still running the current job.
+  bool stopping;
+
+  State () : job (0), jobs (0), running (0), stopping (false) {}
+
+  void work (size_t i) {
+    uint64_t done = 0;
+    std::unique_lock<std::mutex> lock (mutex);
+    for (;;) {
+      wakeup.wait (lock, [this, done] { return stopping || jobs != done; });
+      if (stopping)
+        return;
+      done = jobs;
+      const std::function<void (size_t)> &current = *job;
+      lock.unlock ();
+      current (i);
+      lock.lock ();
+      if (!--running)
+        finished.notify_one ();
+    }
+  }
+};
+
+WorkerPool::WorkerPool () : state (new State ()) {}
+
+WorkerPool::~WorkerPool () {
+  stop ();
+  delete state;
+}
+
+size_t WorkerPool::start (size_t threads) {
+  assert (state->threads.empty ());
+  threads = capped_threads (threads);
+  try {
+    for (size_t i = 1; i < threads; i++)
+      state->threads.emplace_back (&State::work, state, i);
+  } catch (const std::system_error &) {
+  }
+  return size ();
+}
+
+size_t WorkerPool::size () const { return state->threads.size () + 1; }
+
+void WorkerPool::run (const std::function<void (size_t)> &job) {
+  if (state->threads.empty ()) {
+    job (0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock (state->mutex);
+    state->job = &job;
+    state->jobs++;
+    state->running = state->threads.size ();
+  }
+  state->wakeup.notify_all ();
+  job (0);
+  std::unique_lock<std::mutex> lock (state->mutex);
+  state->finished.wait (lock, [this] { return !state->running; });
+  state->job = 0;
+}
+
+void WorkerPool::stop () {
+  if (state->threads.empty ())
+    return;
+  {
+    std::lock_guard<std::mutex> lock (state->mutex);
+    state->stopping = true;
+  }
+  state->wakeup.notify_all ();
+  for (auto &thread : state->threads)
+    thread.join ();
+  state->threads.clear ();
+  state->stopping = false;
+}
+
+} // namespace CaDiCaL
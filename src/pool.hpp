@@ -0,0 +1,47 @@
+#ifndef _pool_hpp_INCLUDED
+#define _pool_hpp_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+namespace CaDiCaL {
+
+// Number of threads to use if 'requested' are asked for, which is capped
+// by the number of hardware threads (if known).  Independently of this
+// callers still have to cope with thread creation failing.
+
+size_t capped_threads (size_t requested);
+
+// Pool of worker threads which are started once (for instance for a whole
+// 'subsume_round') and then repeatedly run the same kind of short job on
+// all workers.  The calling thread takes part as worker zero.  If creating
+// some of the threads fails (because of resource limits) the pool just
+// gets smaller, down to the calling thread alone, which then runs each job
+// sequentially.  The state is kept out of this header to avoid including
+// the thread headers everywhere.
+
+class WorkerPool {
+
+  struct State;
+  State *state;
+
+public:
+  WorkerPool ();
+  ~WorkerPool ();
+
+  // Start up to 'capped_threads (threads)' workers (including the caller).
+  // Returns the number of workers actually available.
+  //
+  size_t start (size_t threads);
+  size_t size () const;
+
+  // Run 'job (i)' on each worker 'i' and wait until all are done.
+  //
+  void run (const std::function<void (size_t)> &job);
+
+  void stop ();
+};
+
+} // namespace CaDiCaL
+
+#endif
@@ -0,0 +1,204 @@
+#include "portfolio.hpp"
+#include "pool.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <system_error>
+#include <thread>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// Capacity of each buffer in integers (4096 binary clauses).
+
+static const size_t buffer_capacity = 1 << 14;
+
+// Sharing learned units and binary clauses.
+
+static const int share_max_size = 2;
+static const int share_max_glue = 2;
+
+/*------------------------------------------------------------------------*/
+
+static const char *configurations[] = {"default", "sat", "unsat", "plain"};
+
+static const int num_configurations =
+    sizeof configurations / sizeof *configurations;
+
+const char *Portfolio::configuration (int id) {
+  assert (id >= 0);
+  return configurations[id % num_configurations];
+}
+
+Portfolio::Portfolio (Solver *s, int t, Terminator *e)
+    : solver (s), threads ((int) capped_threads (std::max (1, t))),
+      terminator (e), conflicts (-1), done (false), res (0), winner (-1) {}
+
+Portfolio::~Portfolio () { delete_buffers (); }
+
+void Portfolio::delete_buffers () {
+  for (auto buffer : buffers)
+    delete buffer;
+  buffers.clear ();
+}
+
+void Portfolio::option (const char *arg) { options.push_back (arg); }
+
+void Portfolio::limit (int c) { conflicts = c; }
+
+int Portfolio::val (int lit) const {
+  assert (res == 10);
+  const int idx = abs (lit);
+  if (idx >= (int) model.size ())
+    return -lit;
+  return model[idx] == idx ? lit : -lit;
+}
+
+bool Portfolio::terminate () {
+  if (done)
+    return true;
+  if (!terminator)
+    return false;
+  std::lock_guard<std::mutex> guard (terminating);
+  return terminator->terminate ();
+}
+
+/*------------------------------------------------------------------------*/
+
+// Copies the irredundant clauses and root-level units of the solver.
+
+struct FormulaCopier : public ClauseIterator {
+  Solver *worker;
+  FormulaCopier (Solver *w) : worker (w) {}
+  bool clause (const std::vector<int> &c) {
+    for (const auto &lit : c)
+      worker->add (lit);
+    worker->add (0);
+    return true;
+  }
+};
+
+// Constructing, copying and deleting solvers touches static state and
+// copying traverses the shared solver (see 'Conquer::new_worker').
+
+Solver *Portfolio::new_worker (int id) {
+  std::lock_guard<std::mutex> guard (copying);
+  Solver *worker = new Solver ();
+  worker->configure (configuration (id));
+  for (const auto &arg : options)
+    if (arg[0] == '-' && arg[1] == '-' &&
+        Solver::is_valid_configuration (arg + 2))
+      worker->configure (arg + 2);
+    else
+      worker->set_long_option (arg);
+  worker->set ("seed", worker->get ("seed") + id);
+  worker->set ("quiet", 1);
+  worker->reserve (solver->vars ());
+  FormulaCopier copier (worker);
+  solver->traverse_clauses (copier);
+  solver->traverse_learned_clauses (copier, 1);
+  worker->connect_terminator (this);
+  return worker;
+}
+
+void Portfolio::delete_worker (Solver *worker) {
+  std::lock_guard<std::mutex> guard (copying);
+  worker->disconnect_terminator ();
+  delete worker;
+}
+
+/*------------------------------------------------------------------------*/
+
+void Portfolio::work (int id) {
+  Solver *worker = new_worker (id);
+  for (int other = 0; other < threads; other++) {
+    if (other == id)
+      continue;
+    worker->connect_export_buffer (buffers[id * threads + other],
+                                   share_max_size, share_max_glue);
+    worker->connect_import_buffer (buffers[other * threads + id]);
+  }
+  if (conflicts >= 0)
+    worker->limit ("conflicts", conflicts);
+  const int tmp = worker->solve ();
+  if (tmp) {
+    std::lock_guard<std::mutex> guard (reporting);
+    if (!done) {
+      if (tmp == 10) {
+        const int max_var = worker->vars ();
+        model.resize (max_var + 1);
+        for (int idx = 1; idx <= max_var; idx++)
+          model[idx] = worker->val (idx);
+      }
+      res = tmp;
+      winner = id;
+      done = true;
+    }
+  }
+  worker->disconnect_export_buffers ();
+  worker->disconnect_import_buffers ();
+  delete_worker (worker);
+}
+
+int Portfolio::solve () {
+  done = false;
+  res = 0;
+  winner = -1;
+  model.clear ();
+
+  delete_buffers ();
+  for (int i = 0; i < threads; i++)
+    for (int j = 0; j < threads; j++)
+      buffers.push_back (i == j ? 0 : new ClauseBuffer (buffer_capacity));
+
+  // If creating worker threads fails we continue with the workers started
+  // so far (clauses exported to the missing ones are just dropped), or run
+  // the first worker in this thread if none could be started.
+
+  std::vector<std::thread> workers;
+  try {
+    for (int i = 0; i < threads; i++)
+      workers.emplace_back (&Portfolio::work, this, i);
+  } catch (const std::system_error &) {
+    if (workers.empty ())
+      work (0);
+  }
+  for (auto &worker : workers)
+    worker.join ();
+
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Only called after all worker threads have been joined.
+
+size_t Portfolio::exported_clauses () const {
+  size_t res = 0;
+  for (const auto &buffer : buffers)
+    if (buffer)
+      res += buffer->pushed ();
+  return res;
+}
+
+size_t Portfolio::imported_clauses () const {
+  size_t res = 0;
+  for (const auto &buffer : buffers)
+    if (buffer)
+      res += buffer->popped ();
+  return res;
+}
+
+size_t Portfolio::dropped_clauses () const {
+  size_t res = 0;
+  for (const auto &buffer : buffers)
+    if (buffer)
+      res += buffer->dropped ();
+  return res;
+}
+
+} // namespace CaDiCaL
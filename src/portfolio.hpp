@@ -0,0 +1,105 @@
+#ifndef _portfolio_hpp_INCLUDED
+#define _portfolio_hpp_INCLUDED
+
+#include "cadical.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace CaDiCaL {
+
+// Helper class for running a portfolio of solvers in parallel threads in
+// applications.  Every worker copies the formula of the given solver once,
+// where worker 'i' uses the pre-defined configuration 'i' of 'default',
+// 'sat', 'unsat' and 'plain' (see 'config.cpp') with the seed incremented
+// by 'i'.  Options given to the portfolio (command line options in the
+// form '--<name>=<val>' or '--<config>') are set after the configuration.
+// The formula is copied as irredundant clauses and root-level units, which
+// is only sound if the solver has not simplified the formula yet (in the
+// application it is copied right after parsing).
+
+// Workers export learned units and binary clauses to every other worker
+// through one single-producer single-consumer 'ClauseBuffer' for each
+// ordered pair of workers, from which these clauses are imported during
+// search at restarts and reductions without locking.  The first worker
+// which determines satisfiability stops all other workers through the
+// 'Terminator' interface and its model is kept.  Workers do not trace
+// proofs.  The number of workers is capped by the number of hardware
+// threads and if creating a worker thread fails the portfolio continues
+// with the workers started so far (or runs the first one itself).
+
+class Portfolio : public Terminator {
+
+  Solver *solver;         // Copied by the workers.
+  int threads;            // Number of worker threads.
+  Terminator *terminator; // Optional external terminator.
+
+  std::vector<const char *> options; // Set for every worker.
+
+  int conflicts; // Limit per worker (negative if unlimited).
+
+  std::atomic<bool> done; // Formula solved by one worker.
+  int res;                // Overall result.
+  int winner;             // Worker which solved the formula.
+
+  std::vector<int> model; // Of the winning worker.
+
+  // Buffer 'buffers[i * threads + j]' from worker 'i' to worker 'j'.
+  //
+  std::vector<ClauseBuffer *> buffers;
+  void delete_buffers ();
+
+  std::mutex copying;     // Serializes creating and deleting workers.
+  std::mutex reporting;   // Serializes setting the result.
+  std::mutex terminating; // Serializes calls to the external terminator.
+
+  Solver *new_worker (int id);
+  void delete_worker (Solver *);
+  void work (int id);
+
+public:
+  Portfolio (Solver *, int threads, Terminator * = 0);
+  ~Portfolio ();
+
+  // Set command line option (or configuration) for every worker.
+  //
+  void option (const char *arg);
+
+  // Set the conflict limit of each worker (negative means none).
+  //
+  void limit (int conflicts);
+
+  // Returns '10' if satisfiable, '20' if unsatisfiable and '0' otherwise.
+  //
+  int solve ();
+
+  // Result of the last call to 'solve'.
+  //
+  int status () const { return res; }
+
+  // Model of the winning worker (as 'Solver::val').
+  //
+  int val (int lit) const;
+
+  // Configuration of worker 'id'.
+  //
+  static const char *configuration (int id);
+
+  // Worker which solved the formula (negative if none did).
+  //
+  int solved_by () const { return winner; }
+
+  // Number of exported, imported and dropped units and binary clauses
+  // (counted once for every receiving worker).
+  //
+  size_t exported_clauses () const;
+  size_t imported_clauses () const;
+  size_t dropped_clauses () const;
+
+  bool terminate ();
+};
+
+} // namespace CaDiCaL
+
+#endif
@@ -217,7 +217,8 @@ void Internal::search_assign_external (int lit) {
 // to reduce the number of times clauses have to be visited (2008 JSAT paper
 // by Chu, Harwood and Stuckey).  The watches know if a watched clause is
 // binary, in which case it never has to be visited.  If a binary clause is
-// falsified we continue propagating.
+// falsified we continue propagating.  Similarly ternary clauses only have
+// to be visited if they are neither satisfied nor falsified.
 
 // Finally, for long clauses we save the position of the last watch
 // replacement in 'pos', which in turn reduces certain quadratic accumulated
@@ -237,6 +238,11 @@ bool Internal::propagate () {
   //
   int64_t before = propagated;
 
+  // Minimum size of clauses searched with vector instructions.
+  //
+  const int simd_size =
+      opts.simd && simd_supported () ? opts.simdsize : INT_MAX;
+
   while (!conflict && propagated != trail.size ()) {
 
     const int lit = -trail[propagated++];
@@ -247,102 +253,155 @@ bool Internal::propagate () {
     watch_iterator j = ws.begin ();
     const_watch_iterator i = j;
 
-    while (i != eow) {
+    // Binary watches come first (see 'keep_binary_watches_first') and are
+    // propagated in this specialized loop, which neither accesses the
+    // clause nor needs to copy watches, since binary watches are never
+    // dropped.  Binary clauses do not require to access the clause at all
+    // (only during conflict analysis, and there also only to simplify the
+    // code).  Only the watches of the larger clauses following them are
+    // visited in the general loop below, unless there is a conflict.
 
-      const Watch w = *j++ = *i++;
+    while (i != eow && i->binary ()) {
+
+      const Watch &w = *i++;
       const signed char b = val (w.blit);
 
       if (b > 0)
         continue; // blocking literal satisfied
 
-      if (w.binary ()) {
+      // assert (w.clause->redundant || !w.clause->garbage);
 
-        // assert (w.clause->redundant || !w.clause->garbage);
-
-        // In principle we can ignore garbage binary clauses too, but that
-        // would require to dereference the clause pointer all the time with
-        //
-        // if (w.clause->garbage) { j--; continue; } // (*)
-        //
-        // This is too costly.  It is however necessary to produce correct
-        // proof traces if binary clauses are traced to be deleted ('d ...'
-        // line) immediately as soon they are marked as garbage.  Actually
-        // finding instances where this happens is pretty difficult (six
-        // parallel fuzzing jobs in parallel took an hour), but it does
-        // occur.  Our strategy to avoid generating incorrect proofs now is
-        // to delay tracing the deletion of binary clauses marked as garbage
-        // until they are really deleted from memory.  For large clauses
-        // this is not necessary since we have to access the clause anyhow.
-        //
-        // Thanks go to Mathias Fleury, who wanted me to explain why the
-        // line '(*)' above was in the code. Removing it actually really
-        // improved running times and thus I tried to find concrete
-        // instances where this happens (which I found), and then
-        // implemented the described fix.
-
-        // Binary clauses are treated separately since they do not require
-        // to access the clause at all (only during conflict analysis, and
-        // there also only to simplify the code).
-
-        if (b < 0)
-          conflict = w.clause; // but continue ...
-        else {
-          build_chain_for_units (w.blit, w.clause, 0);
-          search_assign (w.blit, w.clause);
-          // lrat_chain.clear (); done in search_assign
-        }
+      // In principle we can ignore garbage binary clauses too, but that
+      // would require to dereference the clause pointer all the time with
+      //
+      // if (w.clause->garbage) { j--; continue; } // (*)
+      //
+      // This is too costly.  It is however necessary to produce correct
+      // proof traces if binary clauses are traced to be deleted ('d ...'
+      // line) immediately as soon they are marked as garbage.  Actually
+      // finding instances where this happens is pretty difficult (six
+      // parallel fuzzing jobs in parallel took an hour), but it does
+      // occur.  Our strategy to avoid generating incorrect proofs now is
+      // to delay tracing the deletion of binary clauses marked as garbage
+      // until they are really deleted from memory.  For large clauses
+      // this is not necessary since we have to access the clause anyhow.
+      //
+      // Thanks go to Mathias Fleury, who wanted me to explain why the
+      // line '(*)' above was in the code. Removing it actually really
+      // improved running times and thus I tried to find concrete
+      // instances where this happens (which I found), and then
+      // implemented the described fix.
+
+      if (b < 0)
+        conflict = w.clause; // but continue ...
+      else {
+        build_chain_for_units (w.blit, w.clause, 0);
+        search_assign (w.blit, w.clause);
+        // lrat_chain.clear (); done in search_assign
+      }
+    }
 
-      } else {
-        assert (w.clause->size > 2);
+    if (conflict)
+      break;
 
-        if (conflict)
-          break; // Stop if there was a binary conflict already.
+    j = ws.begin () + (i - ws.begin ());
 
-        // The cache line with the clause data is forced to be loaded here
-        // and thus this first memory access below is the real hot-spot of
-        // the solver.  Note, that this check is positive very rarely and
-        // thus branch prediction should be almost perfect here.
+    while (i != eow) {
+
+      const Watch w = *j++ = *i++;
+
+      // All binary watches were visited in the loop above, since they
+      // precede the watches of larger clauses.
+      //
+      assert (!w.binary ());
+
+      const signed char b = val (w.blit);
 
-        if (w.clause->garbage) {
-          j--;
+      if (b > 0)
+        continue; // blocking literal satisfied
+
+      assert (w.clause->size > 2);
+
+      // Ternary clauses have their two other literals inlined in the watch
+      // (see 'Watch').  Thus the clause does not have to be accessed if
+      // its third literal is satisfied, which only replaces the blocking
+      // literal.  Units and conflicts are still found through the clause
+      // below, which skips garbage clauses.  Units have to be propagated
+      // through watched literals anyhow (conflict analysis, e.g.,
+      // 'on_the_fly_strengthen', relies on that) and conflicts are rare.
+      // Thus, unlike binary clauses, garbage ternary clauses never become
+      // reasons or conflicts and tracing their deletion is not delayed.
+
+      if (w.ternary ()) {
+        const int third = w.third ();
+        if (val (third) > 0) {
+          j[-1].blit = third;
           continue;
         }
+      }
 
-        literal_iterator lits = w.clause->begin ();
-
-        // Simplify code by forcing 'lit' to be the second literal in the
-        // clause.  This goes back to MiniSAT.  We use a branch-less version
-        // for conditionally swapping the first two literals, since it
-        // turned out to be substantially faster than this one
-        //
-        //  if (lits[0] == lit) swap (lits[0], lits[1]);
-        //
-        // which achieves the same effect, but needs a branch.
-        //
-        const int other = lits[0] ^ lits[1] ^ lit;
-        const signed char u = val (other); // value of the other watch
-
-        if (u > 0)
-          j[-1].blit = other; // satisfied, just replace blit
-        else {
-
-          // This follows Ian Gent's (JAIR'13) idea of saving the position
-          // of the last watch replacement.  In essence it needs two copies
-          // of the default search for a watch replacement (in essence the
-          // code in the 'if (v < 0) { ... }' block below), one starting at
-          // the saved position until the end of the clause and then if that
-          // one failed to find a replacement another one starting at the
-          // first non-watched literal until the saved position.
-
-          const int size = w.clause->size;
-          const literal_iterator middle = lits + w.clause->pos;
-          const const_literal_iterator end = lits + size;
-          literal_iterator k = middle;
-
-          // Find replacement watch 'r' at position 'k' with value 'v'.
-
-          int r = 0;
-          signed char v = -1;
+      // The cache line with the clause data is forced to be loaded here
+      // and thus this first memory access below is the real hot-spot of
+      // the solver.  Note, that this check is positive very rarely and
+      // thus branch prediction should be almost perfect here.
+
+      if (w.clause->garbage) {
+        j--;
+        continue;
+      }
+
+      literal_iterator lits = w.clause->begin ();
+
+      // Simplify code by forcing 'lit' to be the second literal in the
+      // clause.  This goes back to MiniSAT.  We use a branch-less version
+      // for conditionally swapping the first two literals, since it
+      // turned out to be substantially faster than this one
+      //
+      //  if (lits[0] == lit) swap (lits[0], lits[1]);
+      //
+      // which achieves the same effect, but needs a branch.
+      //
+      const int other = lits[0] ^ lits[1] ^ lit;
+      const signed char u = val (other); // value of the other watch
+
+      if (u > 0)
+        j[-1].blit = other; // satisfied, just replace blit
+      else {
+
+        // This follows Ian Gent's (JAIR'13) idea of saving the position
+        // of the last watch replacement.  In essence it needs two copies
+        // of the default search for a watch replacement (in essence the
+        // code in the 'if (v < 0) { ... }' block below), one starting at
+        // the saved position until the end of the clause and then if that
+        // one failed to find a replacement another one starting at the
+        // first non-watched literal until the saved position.
+
+        const int size = w.clause->size;
+        const literal_iterator middle = lits + w.clause->pos;
+        const const_literal_iterator end = lits + size;
+        literal_iterator k = middle;
+
+        // Find replacement watch 'r' at position 'k' with value 'v'.
+
+        int r = 0;
+        signed char v = -1;
+
+        // For long clauses the values of the literals are gathered with
+        // vector instructions if supported (see 'simd.hpp').
+
+        if (size >= simd_size) {
+
+          k = simd_find_non_false (vals, k, lits + size);
+          if (k != end)
+            v = val (r = *k);
+
+          if (v < 0) {
+            k = simd_find_non_false (vals, lits + 2, middle);
+            if (k != middle)
+              v = val (r = *k);
+          }
+
+        } else {
 
           while (k != end && (v = val (r = *k)) < 0)
             k++;
@@ -354,89 +413,89 @@ bool Internal::propagate () {
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
+        }
 
-          w.clause->pos = k - lits; // always save position
+        w.clause->pos = k - lits; // always save position
 
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+        assert (lits + 2 <= k), assert (k <= w.clause->end ());
 
-          if (v > 0) {
+        if (v > 0) {
 
-            // Replacement satisfied, so just replace 'blit'.
+          // Replacement satisfied, so just replace 'blit'.
 
-            j[-1].blit = r;
+          j[-1].blit = r;
 
-          } else if (!v) {
+        } else if (!v) {
 
-            // Found new unassigned replacement literal to be watched.
+          // Found new unassigned replacement literal to be watched.
 
-            LOG (w.clause, "unwatch %d in", lit);
+          LOG (w.clause, "unwatch %d in", lit);
 
-            lits[0] = other;
-            lits[1] = r;
-            *k = lit;
+          lits[0] = other;
+          lits[1] = r;
+          *k = lit;
 
-            watch_literal (r, lit, w.clause);
+          watch_literal (r, lit, w.clause);
 
-            j--; // Drop this watch from the watch list of 'lit'.
+          j--; // Drop this watch from the watch list of 'lit'.
 
-          } else if (!u) {
+        } else if (!u) {
 
-            assert (v < 0);
+          assert (v < 0);
 
-            // The other watch is unassigned ('!u') and all other literals
-            // assigned to false (still 'v < 0'), thus we found a unit.
-            //
-            build_chain_for_units (other, w.clause, 0);
-            search_assign (other, w.clause);
-            // lrat_chain.clear (); done in search_assign
+          // The other watch is unassigned ('!u') and all other literals
+          // assigned to false (still 'v < 0'), thus we found a unit.
+          //
+          build_chain_for_units (other, w.clause, 0);
+          search_assign (other, w.clause);
+          // lrat_chain.clear (); done in search_assign
 
-            // Similar code is in the implementation of the SAT'18 paper on
-            // chronological backtracking but in our experience, this code
-            // first does not really seem to be necessary for correctness,
-            // and further does not improve running time either.
-            //
-            if (opts.chrono > 1) {
+          // Similar code is in the implementation of the SAT'18 paper on
+          // chronological backtracking but in our experience, this code
+          // first does not really seem to be necessary for correctness,
+          // and further does not improve running time either.
+          //
+          if (opts.chrono > 1) {
 
-              const int other_level = var (other).level;
+            const int other_level = var (other).level;
 
-              if (other_level > var (lit).level) {
+            if (other_level > var (lit).level) {
 
-                // The assignment level of the new unit 'other' is larger
-                // than the assignment level of 'lit'.  Thus we should find
-                // another literal in the clause at that higher assignment
-                // level and watch that instead of 'lit'.
+              // The assignment level of the new unit 'other' is larger
+              // than the assignment level of 'lit'.  Thus we should find
+              // another literal in the clause at that higher assignment
+              // level and watch that instead of 'lit'.
 
-                assert (size > 2);
+              assert (size > 2);
 
-                int pos, s = 0;
+              int pos, s = 0;
 
-                for (pos = 2; pos < size; pos++)
-                  if (var (s = lits[pos]).level == other_level)
-                    break;
+              for (pos = 2; pos < size; pos++)
+                if (var (s = lits[pos]).level == other_level)
+                  break;
 
-                assert (s);
-                assert (pos < size);
+              assert (s);
+              assert (pos < size);
 
-                LOG (w.clause, "unwatch %d in", lit);
-                lits[pos] = lit;
-                lits[0] = other;
-                lits[1] = s;
-                watch_literal (s, other, w.clause);
+              LOG (w.clause, "unwatch %d in", lit);
+              lits[pos] = lit;
+              lits[0] = other;
+              lits[1] = s;
+              watch_literal (s, other, w.clause);
 
-                j--; // Drop this watch from the watch list of 'lit'.
-              }
+              j--; // Drop this watch from the watch list of 'lit'.
             }
-          } else {
+          }
+        } else {
 
-            assert (u < 0);
-            assert (v < 0);
+          assert (u < 0);
+          assert (v < 0);
 
-            // The other watch is assigned false ('u < 0') and all other
-            // literals as well (still 'v < 0'), thus we found a conflict.
+          // The other watch is assigned false ('u < 0') and all other
+          // literals as well (still 'v < 0'), thus we found a conflict.
 
-            conflict = w.clause;
-            break;
-          }
+          conflict = w.clause;
+          break;
         }
       }
     }
@@ -234,6 +234,12 @@ void Internal::reduce () {
 
   last.reduce.conflicts = stats.conflicts;
 
+  if (importing ())
+    import_shared_clauses ();
+
+  if (opts.vivifybackground || background_vivifier)
+    vivify_in_background ();
+
 DONE:
 
   report (flush ? 'f' : '-');
@@ -126,6 +126,8 @@ void Internal::restart () {
     stats.restartstable++;
   LOG ("restart %" PRId64 "", stats.restarts);
   backtrack (reuse_trail ());
+  if (importing ())
+    import_shared_clauses ();
 
   lim.restart = stats.conflicts + opts.restartint;
   LOG ("new restart limit at %" PRId64 " conflicts", lim.restart);
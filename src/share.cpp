@@ -0,0 +1,249 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Lock-free clause sharing through bounded single-producer single-consumer
+// ring buffers.  Learned clauses are exported in 'analyze' to all
+// connected export buffers which accept them by size and glue.  Clauses in
+// connected import buffers are only imported at restarts (after reusing
+// the trail) and reductions and then added as redundant clauses, where we
+// only backtrack as far as needed to watch them properly.
+
+// In the proof an imported clause is added as original clause, i.e., as
+// axiom, since it was derived by another solver.  This is sound as long
+// as all solvers connected through buffers start from the same formula,
+// because then each imported clause is implied by that formula, justified
+// by the proof of the exporting solver.  Learned clauses never depend on
+// assumptions, which are just decisions, but clauses added by one solver
+// only (for instance a cube added as units) must not be shared.  Checking
+// the proof of a single solver thus only checks its own derivations
+// relative to the imported clauses, while checking all derivations needs
+// the proofs of all solvers.
+
+ClauseBuffer::ClauseBuffer (size_t c)
+    : data (new int[c]), capacity (c), head (0), tail (0),
+      pushed_clauses (0), dropped_clauses (0), popped_clauses (0) {}
+
+ClauseBuffer::~ClauseBuffer () { delete[] data; }
+
+bool ClauseBuffer::push (const int *literals, size_t size, int glue) {
+  const size_t t = tail.load (std::memory_order_relaxed);
+  const size_t h = head.load (std::memory_order_acquire);
+  assert (t - h <= capacity);
+  if (capacity - (t - h) < size + 2) {
+    dropped_clauses++;
+    return false;
+  }
+  data[t % capacity] = (int) size;
+  data[(t + 1) % capacity] = glue;
+  for (size_t i = 0; i < size; i++)
+    data[(t + 2 + i) % capacity] = literals[i];
+  tail.store (t + size + 2, std::memory_order_release);
+  pushed_clauses++;
+  return true;
+}
+
+bool ClauseBuffer::pop (std::vector<int> &clause, int &glue) {
+  const size_t h = head.load (std::memory_order_relaxed);
+  const size_t t = tail.load (std::memory_order_acquire);
+  if (h == t)
+    return false;
+  const size_t size = data[h % capacity];
+  assert (h + size + 2 <= t);
+  glue = data[(h + 1) % capacity];
+  clause.clear ();
+  for (size_t i = 0; i < size; i++)
+    clause.push_back (data[(h + 2 + i) % capacity]);
+  head.store (h + size + 2, std::memory_order_release);
+  popped_clauses++;
+  return true;
+}
+
+bool ClauseBuffer::empty () const {
+  return head.load (std::memory_order_relaxed) ==
+         tail.load (std::memory_order_acquire);
+}
+
+/*------------------------------------------------------------------------*/
+
+// The clause is externalized only once and only if at least one buffer
+// accepts it.
+
+void External::export_shared_clause (const vector<int> &clause, int glue) {
+  const size_t size = clause.size ();
+  shared.clear ();
+  for (const auto &e : export_buffers) {
+    if (size > (size_t) e.max_size || glue > e.max_glue)
+      continue;
+    if (shared.size () < size)
+      for (const auto &ilit : clause)
+        shared.push_back (internal->externalize (ilit));
+    if (e.buffer->push (shared.data (), size, glue)) {
+      LOG (clause, "exported glue %d", glue);
+      internal->stats.shared.exported++;
+    } else {
+      LOG (clause, "dropped glue %d", glue);
+      internal->stats.shared.dropped++;
+    }
+  }
+  shared.clear ();
+}
+
+/*------------------------------------------------------------------------*/
+
+bool Internal::importing () {
+  for (const auto &buffer : external->import_buffers)
+    if (!buffer->empty ())
+      return true;
+  return false;
+}
+
+// Imported clauses are simplified similar to original clauses in
+// 'add_new_original_clause', i.e., we remove root-level falsified literals
+// and duplicates (deriving a new clause in the proof) and skip satisfied
+// clauses.  We also skip clauses with variables which are not internal
+// (yet) or not active anymore (eliminated, substituted or pure), since
+// adding them would require to reactivate those variables.
+
+void Internal::import_shared_clause (const vector<int> &eclause,
+                                     int glue) {
+  assert (!unsat);
+  assert (clause.empty ());
+  assert (original.empty ());
+  assert (lrat_chain.empty ());
+  bool skip = false;
+  for (const auto &elit : eclause) {
+    const int eidx = abs (elit);
+    const int iidx = eidx <= external->max_var ? external->e2i[eidx] : 0;
+    if (!iidx || (!flags (iidx).active () && !flags (iidx).fixed ())) {
+      LOG (eclause, "inactive external variable %d in imported", eidx);
+      skip = true;
+      break;
+    }
+    original.push_back (elit < 0 ? -iidx : iidx);
+  }
+  if (!skip) {
+    for (const auto &lit : original) {
+      int tmp = marked (lit);
+      if (tmp > 0)
+        continue;
+      if (tmp < 0) {
+        LOG (original, "tautological imported");
+        skip = true;
+        break;
+      }
+      mark (lit);
+      tmp = fixed (lit);
+      if (tmp > 0) {
+        LOG (original, "satisfied imported");
+        skip = true;
+        break;
+      }
+      if (!tmp)
+        clause.push_back (lit);
+      else if (lrat) {
+        const int elit = externalize (lit);
+        const unsigned eidx = (elit > 0) + 2u * (unsigned) abs (elit);
+        if (!external->ext_units[eidx]) {
+          const uint64_t uid = unit_clauses[vlit (-lit)];
+          assert (uid);
+          lrat_chain.push_back (uid);
+        }
+      }
+    }
+    for (const auto &lit : original)
+      unmark (lit);
+  }
+  if (skip) {
+    stats.shared.skipped++;
+    original.clear ();
+    clause.clear ();
+    lrat_chain.clear ();
+    return;
+  }
+  stats.shared.imported++;
+  const uint64_t id = ++clause_id;
+  if (proof)
+    proof->add_external_original_clause (id, true, eclause);
+  uint64_t new_id = id;
+  const size_t size = clause.size ();
+  if (original.size () > size) {
+    new_id = ++clause_id;
+    if (proof) {
+      if (lrat)
+        lrat_chain.push_back (id);
+      proof->add_derived_clause (new_id, true, clause, lrat_chain);
+      proof->delete_external_original_clause (id, true, eclause);
+    }
+  }
+  original.clear ();
+  lrat_chain.clear ();
+  if (!size) {
+    LOG ("imported falsified clause");
+    backtrack ();
+    unsat = true;
+    conflict_id = new_id;
+    marked_failed = true;
+    conclusion.push_back (new_id);
+  } else if (size == 1) {
+    backtrack ();
+    assign_original_unit (new_id, clause[0]);
+  } else {
+    import_backtrack ();
+    Clause *c = new_clause (true, glue, new_id);
+    LOG (c, "imported");
+    watch_clause (c);
+  }
+  clause.clear ();
+}
+
+// Backtrack before watching the imported clause in 'clause' only as far
+// as needed to make its two watched literals non-false, unless the first
+// one is true and assigned before the second one (as in
+// 'vivify_strengthen').  Then the clause does not need to be propagated.
+
+void Internal::import_backtrack () {
+  if (!level)
+    return;
+  move_literals_to_watch ();
+  int new_level = level;
+  const int lit0 = clause[0];
+  const signed char val0 = val (lit0);
+  if (val0 < 0) {
+    const int level0 = var (lit0).level;
+    LOG ("1st watch %d negative at level %d", lit0, level0);
+    new_level = level0 - 1;
+  }
+  const int lit1 = clause[1];
+  const signed char val1 = val (lit1);
+  if (val1 < 0 && !(val0 > 0 && var (lit0).level <= var (lit1).level)) {
+    const int level1 = var (lit1).level;
+    LOG ("2nd watch %d negative at level %d", lit1, level1);
+    if (level1 - 1 < new_level)
+      new_level = level1 - 1;
+  }
+  if (new_level < level)
+    backtrack (new_level);
+  assert (val (lit0) >= 0);
+  assert (val (lit1) >= 0 || (val (lit0) > 0 &&
+                              var (lit0).level <= var (lit1).level));
+}
+
+// Called at restarts and reductions if some import buffer is non-empty.
+// Imported units are propagated immediately in 'assign_original_unit'
+// after backtracking to the root-level.
+
+void Internal::import_shared_clauses () {
+  assert (importing ());
+  vector<int> &eclause = external->shared;
+  assert (eclause.empty ());
+  int glue;
+  for (const auto &buffer : external->import_buffers)
+    while (!unsat && buffer->pop (eclause, glue))
+      import_shared_clause (eclause, glue);
+  eclause.clear ();
+}
+
+} // namespace CaDiCaL
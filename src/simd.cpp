@@ -0,0 +1,62 @@
+#include "internal.hpp"
+
+#if !defined(NSIMD) && defined(__GNUC__) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define AVX2
+#include <immintrin.h>
+#endif
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+static inline int *scalar_find_non_false (const signed char *vals,
+                                          int *k, int *end) {
+  while (k != end && vals[*k] < 0)
+    k++;
+  return k;
+}
+
+#ifdef AVX2
+
+// Only this function is compiled for AVX2, which allows to use it in a
+// portable binary as long we check 'simd_supported' before calling it.
+// The four gathered bytes per literal are shifted to keep only the value
+// of the literal in the most significant byte, which gives its sign.
+
+__attribute__ ((target ("avx2"))) static int *
+avx2_find_non_false (const signed char *vals, int *k, int *end) {
+  while (end - k >= 8) {
+    const __m256i lits = _mm256_loadu_si256 ((const __m256i *) k);
+    const __m256i gathered =
+        _mm256_i32gather_epi32 ((const int *) vals, lits, 1);
+    const __m256i values = _mm256_slli_epi32 (gathered, 24);
+    const int falsified =
+        _mm256_movemask_ps (_mm256_castsi256_ps (values));
+    if (falsified != 0xff)
+      return k + __builtin_ctz (~falsified);
+    k += 8;
+  }
+  return scalar_find_non_false (vals, k, end);
+}
+
+bool simd_supported () {
+  static const bool supported = __builtin_cpu_supports ("avx2");
+  return supported;
+}
+
+int *simd_find_non_false (const signed char *vals, int *begin, int *end) {
+  return avx2_find_non_false (vals, begin, end);
+}
+
+#else
+
+bool simd_supported () { return false; }
+
+int *simd_find_non_false (const signed char *vals, int *begin, int *end) {
+  return scalar_find_non_false (vals, begin, end);
+}
+
+#endif
+
+} // namespace CaDiCaL
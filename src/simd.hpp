@@ -0,0 +1,28 @@
+#ifndef _simd_hpp_INCLUDED
+#define _simd_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+// Vectorized search for a replacement watch in long clauses in 'propagate'
+// (independent from 'Internal').  On x86 processors supporting AVX2 the
+// values of eight literals are gathered from 'vals' at once.  This is
+// selected at run-time, and otherwise (or if compiled with '-DNSIMD') we
+// fall back to the scalar search.  Gathering reads four bytes at 'vals +
+// lit' and thus 'vals' needs 'simd_vals_padding' bytes after the value of
+// the largest literal.  It is disabled by default ('--simd=false') since
+// starting at the saved position the scalar search usually stops after a
+// few literals, and in our measurements on long-clause instances gathering
+// was not faster than the scalar search.
+
+const unsigned simd_vals_padding = 3;
+
+bool simd_supported ();
+
+// Return the first literal position in '[begin,end)' with a literal not
+// assigned to false, or 'end' if all literals are false.
+
+int *simd_find_non_false (const signed char *vals, int *begin, int *end);
+
+} // namespace CaDiCaL
+
+#endif
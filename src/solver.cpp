@@ -656,16 +656,46 @@ int Solver::lookahead () {
   return lit;
 }
 
+int Solver::call_generate_cubes (int depth, int min_depth,
+                                 CubeIterator &it) {
+  if (internal->opts.cubethreads && (state () & READY)) {
+    Cuber cuber (this, external);
+    return cuber.generate (depth, min_depth, it);
+  }
+  return external->generate_cubes (depth, min_depth, it);
+}
+
 Solver::CubesWithStatus Solver::generate_cubes (int depth, int min_depth) {
   TRACE ("lookahead_cubes");
   REQUIRE_VALID_OR_SOLVING_STATE ();
-  auto cubes = external->generate_cubes (depth, min_depth);
+  CubeCollector collector;
+  CubesWithStatus cubes;
+  cubes.status = call_generate_cubes (depth, min_depth, collector);
+  cubes.cubes = std::move (collector.cubes);
   TRACE ("lookahead_cubes");
+  return cubes;
+}
 
-  CubesWithStatus cubes2;
-  cubes2.status = cubes.status;
-  cubes2.cubes = cubes.cubes;
-  return cubes2;
+vector<vector<vector<int>>>
+Solver::shard_cubes (const vector<vector<int>> &cubes, int shards) {
+  LOG_API_CALL_BEGIN ("shard_cubes", shards);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (shards > 0, "invalid number of shards %d", shards);
+  for (const auto &cube : cubes)
+    for (const auto &lit : cube)
+      REQUIRE_VALID_LIT (lit);
+  vector<vector<vector<int>>> res;
+  external->shard_cubes (cubes, shards, res);
+  LOG_API_CALL_END ("shard_cubes", shards);
+  return res;
+}
+
+int Solver::generate_cubes (int depth, CubeIterator &it, int min_depth) {
+  TRACE ("lookahead_cubes");
+  REQUIRE_VALID_OR_SOLVING_STATE ();
+  int res = call_generate_cubes (depth, min_depth, it);
+  TRACE ("lookahead_cubes");
+  return res;
 }
 
 void Solver::reset_assumptions () {
@@ -942,6 +972,45 @@ void Solver::disconnect_fixed_listener () {
   LOG_API_CALL_END ("disconnect_fixed_listener");
 }
 
+/*------------------------------------------------------------------------*/
+
+void Solver::connect_export_buffer (ClauseBuffer *buffer, int max_size,
+                                    int max_glue) {
+  LOG_API_CALL_BEGIN ("connect_export_buffer");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (buffer, "can not connect zero export buffer");
+  REQUIRE (max_size >= 0, "negative maximum size of exported clauses");
+  REQUIRE (max_glue >= 0, "negative maximum glue of exported clauses");
+  External::ExportBuffer e;
+  e.buffer = buffer;
+  e.max_size = max_size;
+  e.max_glue = max_glue;
+  external->export_buffers.push_back (e);
+  LOG_API_CALL_END ("connect_export_buffer");
+}
+
+void Solver::disconnect_export_buffers () {
+  LOG_API_CALL_BEGIN ("disconnect_export_buffers");
+  REQUIRE_VALID_STATE ();
+  external->export_buffers.clear ();
+  LOG_API_CALL_END ("disconnect_export_buffers");
+}
+
+void Solver::connect_import_buffer (ClauseBuffer *buffer) {
+  LOG_API_CALL_BEGIN ("connect_import_buffer");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (buffer, "can not connect zero import buffer");
+  external->import_buffers.push_back (buffer);
+  LOG_API_CALL_END ("connect_import_buffer");
+}
+
+void Solver::disconnect_import_buffers () {
+  LOG_API_CALL_BEGIN ("disconnect_import_buffers");
+  REQUIRE_VALID_STATE ();
+  external->import_buffers.clear ();
+  LOG_API_CALL_END ("disconnect_import_buffers");
+}
+
 /*===== IPASIR-UP BEGIN ==================================================*/
 
 void Solver::connect_external_propagator (ExternalPropagator *propagator) {
@@ -1445,6 +1514,17 @@ bool Solver::traverse_clauses (ClauseIterator &it) const {
   return res;
 }
 
+bool Solver::traverse_learned_clauses (ClauseIterator &it,
+                                       int max_size) const {
+  LOG_API_CALL_BEGIN ("traverse_learned_clauses", max_size);
+  REQUIRE_VALID_STATE ();
+  bool res =
+      external->traverse_all_units_and_equivalences_as_clauses (it) &&
+      internal->traverse_redundant_clauses (it, max_size);
+  LOG_API_CALL_RETURNS ("traverse_learned_clauses", max_size, res);
+  return res;
+}
+
 bool Solver::traverse_witnesses_backward (WitnessIterator &it) const {
   LOG_API_CALL_BEGIN ("traverse_witnesses_backward");
   REQUIRE_VALID_STATE ();
@@ -1542,6 +1622,115 @@ const char *Solver::write_dimacs (const char *path, int min_max_var) {
 
 /*------------------------------------------------------------------------*/
 
+class CubeWriter : public CubeIterator {
+  File *file;
+
+public:
+  int64_t cubes;
+  bool failed;
+  CubeWriter (File *f) : file (f), cubes (0), failed (false) {}
+  bool cube (const vector<int> &c) {
+    failed = !file->put ('a');
+    for (const auto &lit : c)
+      if (!failed)
+        failed = !file->put (' ') || !file->put (lit);
+    if (!failed)
+      failed = !file->put (" 0\n");
+    cubes++;
+    return !failed;
+  }
+};
+
+const char *Solver::write_cubes (const char *path, int depth, bool inccnf,
+                                 int min_depth) {
+  LOG_API_CALL_BEGIN ("write_cubes", path, depth);
+  REQUIRE_VALID_STATE ();
+  REQUIRE (depth >= 0, "negative cube depth %d", depth);
+
+  // In 'inccnf' mode clauses have to be written before all cubes, but
+  // should include what was learned during generating the cubes.
+
+  const char *res = 0;
+  if (inccnf) {
+    CubeCollector collector;
+    if (call_generate_cubes (depth, min_depth, collector) == 10)
+      collector.cubes.push_back (vector<int> ());
+    res = write_cubes (path, collector.cubes, true);
+  } else {
+#ifndef QUIET
+    const double start = internal->time ();
+#endif
+    File *file = File::write (internal, path);
+    if (file) {
+      CubeWriter writer (file);
+      if (call_generate_cubes (depth, min_depth, writer) == 10)
+        (void) writer.cube (vector<int> ());
+      if (writer.failed)
+        res = internal->error_message.init (
+            "writing to cubes file '%s' failed", path);
+      delete file;
+#ifndef QUIET
+      if (!res) {
+        const double end = internal->time ();
+        MSG ("wrote %" PRId64 " cubes in %.2f seconds %s time",
+             writer.cubes, end - start,
+             internal->opts.realtime ? "real" : "process");
+      }
+#endif
+    } else
+      res = internal->error_message.init (
+          "failed to open cubes file '%s' for writing", path);
+  }
+  LOG_API_CALL_RETURNS ("write_cubes", path, depth, res);
+  return res;
+}
+
+const char *Solver::write_cubes (const char *path,
+                                 const vector<vector<int>> &cubes,
+                                 bool inccnf) {
+  LOG_API_CALL_BEGIN ("write_cubes", path, (int) cubes.size ());
+  REQUIRE_VALID_STATE ();
+#ifndef QUIET
+  const double start = internal->time ();
+#endif
+  File *file = File::write (internal, path);
+  const char *res = 0;
+  if (file) {
+    bool failed = false;
+    if (inccnf) {
+      internal->restore_clauses ();
+      MSG ("writing %s'p inccnf'%s header", tout.green_code (),
+           tout.normal_code ());
+      ClauseWriter writer (file);
+      const int max_size = internal->opts.cubelearned;
+      failed = !file->put ("p inccnf\n") || !traverse_clauses (writer) ||
+               (max_size && !traverse_learned_clauses (writer, max_size));
+    }
+    CubeWriter writer (file);
+    for (const auto &cube : cubes)
+      if (!failed)
+        failed = !writer.cube (cube);
+    if (failed)
+      res = internal->error_message.init (
+          "writing to cubes file '%s' failed", path);
+    delete file;
+#ifndef QUIET
+    if (!res) {
+      const double end = internal->time ();
+      MSG ("wrote %" PRId64 " cubes in %.2f seconds %s time",
+           writer.cubes, end - start,
+           internal->opts.realtime ? "real" : "process");
+    }
+#endif
+  } else
+    res = internal->error_message.init (
+        "failed to open cubes file '%s' for writing", path);
+  LOG_API_CALL_RETURNS ("write_cubes", path, (int) cubes.size (), res);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 struct WitnessWriter : public WitnessIterator {
   File *file;
   int64_t witnesses;
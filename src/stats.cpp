@@ -130,6 +130,29 @@ void Stats::print (Internal *internal) {
          stats.cover.blocked,
          percent (stats.cover.blocked, stats.cover.total));
   }
+  if (all || stats.cube.cubes) {
+    PRT ("cubes:           %15" PRId64 "   %10.2f    nodes per cube",
+         stats.cube.cubes,
+         relative (stats.cube.nodes + stats.cube.cheap, stats.cube.cubes));
+    PRT ("  cubenodes:     %15" PRId64 "   %10.2f    probes per node",
+         stats.cube.nodes, relative (stats.cube.probes, stats.cube.nodes));
+    PRT ("  cubecheap:     %15" PRId64 "   %10.2f %%  of split nodes",
+         stats.cube.cheap,
+         percent (stats.cube.cheap, stats.cube.nodes + stats.cube.cheap));
+    PRT ("  cubeprobes:    %15" PRId64 "   %10.2f %%  of candidates",
+         stats.cube.probes,
+         percent (stats.cube.probes, stats.cube.probes + stats.cube.cached));
+    PRT ("  cubecached:    %15" PRId64 "   %10.2f %%  of candidates",
+         stats.cube.cached,
+         percent (stats.cube.cached, stats.cube.probes + stats.cube.cached));
+    PRT ("  cubedoubles:   %15" PRId64 "   %10.2f    per node",
+         stats.cube.doubles, relative (stats.cube.doubles, stats.cube.nodes));
+    PRT ("  cubedfailed:   %15" PRId64 "   %10.2f %%  per double lookahead",
+         stats.cube.dfailed,
+         percent (stats.cube.dfailed, stats.cube.doubles));
+    PRT ("  cubegates:     %15" PRId64 "   %10.2f %%  of variables",
+         stats.cube.gates, percent (stats.cube.gates, internal->max_var));
+  }
   if (all || stats.decisions) {
     PRT ("decisions:       %15" PRId64 "   %10.2f    per second",
          stats.decisions, relative (stats.decisions, t));
@@ -145,6 +168,10 @@ void Stats::print (Internal *internal) {
          stats.elimrounds, relative (stats.elimrounds, stats.elimphases));
     PRT ("  elimtried:     %15" PRId64 "   %10.2f %%  eliminated",
          stats.elimtried, percent (stats.all.eliminated, stats.elimtried));
+    PRT ("  elimbatches:   %15" PRId64 "   %10.2f    per round",
+         stats.elimbatches, relative (stats.elimbatches, stats.elimrounds));
+    PRT ("  elimcounted:   %15" PRId64 "   %10.2f %%  per tried",
+         stats.elimcounted, percent (stats.elimcounted, stats.elimtried));
     PRT ("  elimgates:     %15" PRId64 "   %10.2f %%  gates per tried",
          stats.elimgates, percent (stats.elimgates, stats.elimtried));
     PRT ("  elimequivs:    %15" PRId64 "   %10.2f %%  equivalence gates",
@@ -191,6 +218,21 @@ void Stats::print (Internal *internal) {
          stats.ext_prop.echeck_call,
          percent (stats.ext_prop.echeck_call, stats.ext_prop.ext_cb));
   }
+  if (all || stats.shared.exported || stats.shared.imported ||
+      stats.shared.skipped) {
+    PRT ("shared exported: %15" PRId64 "   %10.2f %%  per learned",
+         stats.shared.exported,
+         percent (stats.shared.exported, stats.learned.clauses));
+    PRT ("  dropped:       %15" PRId64 "   %10.2f %%  per exported",
+         stats.shared.dropped,
+         percent (stats.shared.dropped, stats.shared.exported));
+    PRT ("shared imported: %15" PRId64 "   %10.2f %%  per conflict",
+         stats.shared.imported,
+         percent (stats.shared.imported, stats.conflicts));
+    PRT ("  skipped:       %15" PRId64 "   %10.2f %%  per imported",
+         stats.shared.skipped,
+         percent (stats.shared.skipped, stats.shared.imported));
+  }
   if (all || stats.all.fixed) {
     PRT ("fixed:           %15" PRId64 "   %10.2f %%  of all variables",
          stats.all.fixed, percent (stats.all.fixed, stats.vars));
@@ -431,6 +473,8 @@ void Stats::print (Internal *internal) {
          stats.subchecks, relative (stats.subchecks, stats.subtried));
     PRT ("  subchecks2:    %15" PRId64 "   %10.2f %%  per subcheck",
          stats.subchecks2, percent (stats.subchecks2, stats.subchecks));
+    PRT ("  subbatches:    %15" PRId64 "   %10.2f    per round",
+         stats.subbatches, relative (stats.subbatches, stats.subsumerounds));
     PRT ("  elimotfsub:    %15" PRId64 "   %10.2f %%  of subsumed",
          stats.elimotfsub, percent (stats.elimotfsub, stats.subsumed));
     PRT ("  elimbwsub:     %15" PRId64 "   %10.2f %%  of subsumed",
@@ -510,6 +554,12 @@ void Stats::print (Internal *internal) {
     PRT ("  vivifyreused:  %15" PRId64 "   %10.2f %%  per decision",
          stats.vivifyreused,
          percent (stats.vivifyreused, stats.vivifydecs));
+    PRT ("  vivifybgchecks:%15" PRId64 "   %10.2f %%  per vivify check",
+         stats.vivifybgchecks,
+         percent (stats.vivifybgchecks, stats.vivifychecks));
+    PRT ("  vivifybgfound: %15" PRId64 "   %10.2f %%  per background check",
+         stats.vivifybgfound,
+         percent (stats.vivifybgfound, stats.vivifybgchecks));
   }
   if (all || stats.walk.count) {
     PRT ("walked:          %15" PRId64 "   %10.2f    interval",
@@ -43,6 +43,13 @@ struct Stats {
     int64_t echeck_call; // number of checking found complete solutions
   } ext_prop;
 
+  struct {
+    int64_t exported; // learned clauses exported to buffers
+    int64_t dropped;  // exported clauses dropped due to full buffers
+    int64_t imported; // imported clauses added
+    int64_t skipped;  // imported clauses satisfied or with inactive vars
+  } shared;
+
   int64_t condassinit;  // initial assigned literals
   int64_t condassirem;  // initial assigned literals for blocked
   int64_t condassrem;   // remaining assigned literals for blocked
@@ -80,6 +87,17 @@ struct Stats {
     int64_t total;      // total number of eliminated clauses
   } cover;
 
+  struct {
+    int64_t nodes;  // cube tree nodes with lookahead
+    int64_t cheap;  // cube tree nodes split by occurrences
+    int64_t cubes;  // generated cubes
+    int64_t probes; // probed candidates during lookahead
+    int64_t cached; // candidates with cached lookahead score
+    int64_t doubles; // double lookahead tried
+    int64_t dfailed; // double lookahead failed literals
+    int64_t gates;   // gate outputs not split on
+  } cube;
+
   struct {
     int64_t tried;
     int64_t succeeded;
@@ -156,6 +174,7 @@ struct Stats {
   int64_t subtried;  // number of tried subsumptions
   int64_t subchecks; // number of pair-wise subsumption checks
   int64_t subchecks2;    // same but restricted to binary clauses
+  int64_t subbatches;    // number of parallel subsumption batches
   int64_t elimotfsub;    // number of on-the-fly subsumed during elimination
   int64_t subsumerounds; // number of subsumption rounds
   int64_t subsumephases; // number of scheduled subsumption phases
@@ -167,6 +186,8 @@ struct Stats {
   int64_t elimphases;     // number of scheduled elimination phases
   int64_t elimcompleted;  // number complete elimination procedures
   int64_t elimtried;      // number of variable elimination attempts
+  int64_t elimbatches;    // number of parallel elimination batches
+  int64_t elimcounted;    // number of attempts decided by parallel counts
   int64_t elimsubst;      // number of eliminations through substitutions
   int64_t elimgates;      // number of gates found during elimination
   int64_t elimequivs;     // number of equivalences found during elimination
@@ -194,6 +215,8 @@ struct Stats {
   int64_t vivifystred3;   // strengthened redundant clause (3)
   int64_t vivifyunits;    // units during vivification
   int64_t vivifyinst;     // instantiation during vivification
+  int64_t vivifybgchecks; // checked clauses in background vivification
+  int64_t vivifybgfound;  // vivifiable clauses found in background
   int64_t transreds;
   int64_t transitive;
   struct {
@@ -198,10 +198,13 @@ void Internal::strengthen_clause (Clause *c, int lit) {
 // candidate clause 'c' given as first argument.  If this is the case the
 // clause is subsumed and the result is positive.   If the clause was
 // strengthened the result is negative.  Otherwise the candidate clause
-// can not be subsumed nor strengthened and zero is returned.
+// can not be subsumed nor strengthened and zero is returned.  If the
+// 'subsumer' is given, only clauses connected while committing its batch
+// are checked, since the others have already been checked in parallel.
 
 inline int Internal::try_to_subsume_clause (Clause *c,
-                                            vector<Clause *> &shrunken) {
+                                            vector<Clause *> &shrunken,
+                                            const Subsumer *subsumer) {
 
   stats.subtried++;
   assert (!level);
@@ -239,7 +242,12 @@ inline int Internal::try_to_subsume_clause (Clause *c,
       // literal which can be removed in 'c', otherwise to 'INT_MIN' which
       // is a non-valid literal.
 
-      for (const auto &bin : bins (sign * lit)) {
+      const Bins &bs = bins (sign * lit);
+      size_t i = subsumer ? subsumer->first (subsumer->bins_before,
+                                             vlit (sign * lit), bs.size ())
+                          : 0;
+      for (; i < bs.size (); i++) {
+        const Bin &bin = bs[i];
         const auto &other = bin.lit;
         const int tmp = marked (other);
         if (!tmp)
@@ -280,7 +288,11 @@ inline int Internal::try_to_subsume_clause (Clause *c,
       // code after the loop is used.
       //
       const Occs &os = occs (sign * lit);
-      for (const auto &e : os) {
+      size_t j = subsumer ? subsumer->first (subsumer->occs_before,
+                                             vlit (sign * lit), os.size ())
+                          : 0;
+      for (; j < os.size (); j++) {
+        Clause *e = os[j];
         assert (!e->garbage); // sanity check
         if (e->garbage)
           continue; // defensive: not needed
@@ -298,6 +310,17 @@ inline int Internal::try_to_subsume_clause (Clause *c,
 
   unmark (c);
 
+  return subsume_or_strengthen_clause (c, d, flipped, shrunken);
+}
+
+// Subsume or strengthen the candidate clause 'c' by 'd' as determined by
+// 'flipped' (see 'subsume_check') in 'try_to_subsume_clause' or by a worker
+// thread and return the result of 'try_to_subsume_clause'.
+
+inline int
+Internal::subsume_or_strengthen_clause (Clause *c, Clause *d, int flipped,
+                                        vector<Clause *> &shrunken) {
+
   if (flipped == INT_MIN) {
     LOG (d, "subsuming");
     subsume_clause (d, c);
@@ -323,6 +346,35 @@ inline int Internal::try_to_subsume_clause (Clause *c,
 
 /*------------------------------------------------------------------------*/
 
+// Commit the result of checking the candidate clause 'c' in parallel.  If
+// no (self-)subsuming clause was found, then the candidate still has to be
+// checked against the clauses connected while committing the batch.
+
+inline int Internal::subsume_commit_result (Subsumer &subsumer, Clause *c,
+                                            vector<Clause *> &shrunken) {
+  assert (subsumer.next < subsumer.candidates.size ());
+  assert (subsumer.candidates[subsumer.next] == c);
+  assert (subsumer.next < subsumer.checked);
+  const SubsumeResult &result = subsumer.results[subsumer.next++];
+  stats.subchecks += result.checks;
+  stats.subchecks2 += result.checks2;
+  if (!result.flipped)
+    return try_to_subsume_clause (c, shrunken, &subsumer);
+  stats.subtried++;
+  assert (!level);
+  LOG (c, "checked in parallel");
+  Clause *d = result.subsuming;
+  if (!d) {
+    dummy_binary->literals[0] = result.binary[0];
+    dummy_binary->literals[1] = result.binary[1];
+    dummy_binary->id = result.id;
+    d = dummy_binary;
+  }
+  return subsume_or_strengthen_clause (c, d, result.flipped, shrunken);
+}
+
+/*------------------------------------------------------------------------*/
+
 // Sorting the scheduled clauses is way faster if we compute and save the
 // clause size in the schedule to avoid pointer access to clauses during
 // sorting.  This slightly increases the schedule size though.
@@ -481,7 +533,10 @@ bool Internal::subsume_round () {
   // to find smaller or same size clauses which subsume or might strengthen
   // the candidate.  After the candidate has been processed connect one
   // of its literals (with smallest number of occurrences at this point) in
-  // a one-watched scheme.
+  // a one-watched scheme.  With 'subsumethreads' the candidates are first
+  // checked in batches in parallel against the clauses connected before
+  // the batch and the results are then committed in schedule order (see
+  // 'subsumepar.cpp').
 
   int64_t subsumed = 0, strengthened = 0, checked = 0;
 
@@ -489,14 +544,31 @@ bool Internal::subsume_round () {
   init_occs ();
   init_bins ();
 
-  for (const auto &s : schedule) {
+  Subsumer subsumer;
+  size_t batched = 0;
+  if (opts.subsumethreads)
+    subsumer.pool.start (opts.subsumethreads);
+
+  for (size_t i = 0; i < schedule.size (); i++) {
 
     if (terminated_asynchronously ())
       break;
     if (stats.subchecks >= check_limit)
       break;
 
-    Clause *c = s.clause;
+    if (opts.subsumethreads && i == batched) {
+      vector<Clause *> &candidates = subsumer.candidates;
+      candidates.clear ();
+      while (batched < schedule.size () &&
+             candidates.size () < (size_t) opts.subsumebatch) {
+        Clause *d = schedule[batched++].clause;
+        if (d->size > 2 && d->subsume)
+          candidates.push_back (d);
+      }
+      subsume_check_batch (subsumer, check_limit);
+    }
+
+    Clause *c = schedule[i].clause;
     assert (!c->garbage);
 
     checked++;
@@ -511,7 +583,9 @@ bool Internal::subsume_round () {
     //
     if (c->size > 2 && c->subsume) {
       c->subsume = false;
-      const int tmp = try_to_subsume_clause (c, shrunken);
+      const int tmp = opts.subsumethreads
+                          ? subsume_commit_result (subsumer, c, shrunken)
+                          : try_to_subsume_clause (c, shrunken);
       if (tmp > 0) {
         subsumed++;
         continue;
@@ -565,6 +639,9 @@ bool Internal::subsume_round () {
            "watching %d with %zd current and total %" PRId64 " occurrences",
            minlit, minsize, minoccs);
 
+      if (opts.subsumethreads)
+        subsumer.connect (subsumer.occs_before, vlit (minlit),
+                          occs (minlit).size ());
       occs (minlit).push_back (c);
 
       // This sorting should give faster failures for assumption checks
@@ -592,6 +669,9 @@ bool Internal::subsume_round () {
 
       const int minlit_pos = (c->literals[1] == minlit);
       const int other = c->literals[!minlit_pos];
+      if (opts.subsumethreads)
+        subsumer.connect (subsumer.bins_before, vlit (minlit),
+                          bins (minlit).size ());
       bins (minlit).push_back (Bin{other, c->id});
     }
   }
@@ -0,0 +1,58 @@
+#ifndef _subsume_hpp_INCLUDED
+#define _subsume_hpp_INCLUDED
+
+namespace CaDiCaL {
+
+struct Clause;
+
+// Result of checking a subsumption candidate by a worker thread (see
+// 'subsumepar.cpp').  The 'flipped' literal has the same meaning as the
+// result of 'subsume_check', i.e., it is zero if no subsuming nor
+// strengthening clause was found among the connected clauses.
+
+struct SubsumeResult {
+  Clause *subsuming; // Zero if found in binary clause occurrences.
+  int flipped;       // 'INT_MIN' if subsumed, otherwise negated literal.
+  int binary[2];     // Literals of subsuming binary clause.
+  uint64_t id;       // Identifier of subsuming binary clause.
+  int64_t checks;    // Performed subsumption checks.
+  int64_t checks2;   // Same but restricted to binary clauses.
+};
+
+struct Subsumer {
+
+  vector<Clause *> candidates;   // Of the current batch.
+  vector<SubsumeResult> results; // Of these candidates.
+  size_t checked;                // Candidates checked by workers.
+  size_t next;                   // Next candidate to commit.
+
+  // Occurrence list sizes (plus one) before the first clause was connected
+  // while committing the current batch (zero if none was connected yet),
+  // indexed by 'vlit' of the connected literal.
+  //
+  vector<unsigned> occs_before, bins_before;
+  vector<unsigned> connected;
+
+  // Position of first occurrence connected while committing the batch.
+  //
+  size_t first (const vector<unsigned> &before, unsigned u,
+                size_t size) const {
+    return before[u] ? before[u] - 1 : size;
+  }
+
+  void connect (vector<unsigned> &before, unsigned u, size_t size) {
+    if (before[u])
+      return;
+    before[u] = size + 1;
+    connected.push_back (u);
+  }
+
+  WorkerPool pool;                   // Started for the whole round.
+  vector<vector<signed char>> marks; // Literal marks of worker threads.
+
+  Subsumer () : checked (0), next (0) {}
+};
+
+} // namespace CaDiCaL
+
+#endif
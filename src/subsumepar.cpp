@@ -0,0 +1,163 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <atomic>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// With 'subsumethreads' set the scheduled candidates of 'subsume_round'
+// are processed in batches of 'subsumebatch' clauses.  Worker threads
+// first check each candidate of the batch against the clauses connected
+// before the batch, i.e., the occurrence lists and binary clauses which
+// are not changed while the workers run.  Each worker uses its own literal
+// marks and records the first subsuming or strengthening clause found in
+// the result of the candidate.  The workers are started once per round
+// (see 'WorkerPool') and take the next unchecked candidate of the batch
+// until the remaining check limit is exhausted.  Thus the checked
+// candidates always form a prefix of the batch.
+
+// The results are then committed sequentially in schedule order in
+// 'subsume_round' (see 'subsume_commit_result'), which subsumes or
+// strengthens the candidate and connects it as before.  Candidates for
+// which no result was found are checked sequentially against the clauses
+// connected during committing the batch.  Since those are appended to the
+// occurrence lists we only need to remember the size of each occurrence
+// list before its first clause was connected.  The checks of a candidate
+// are only added to the statistics when it is committed, which makes the
+// check limit apply per candidate as in the sequential case.  Since the
+// checks of the prefix of checked candidates exceed the limit, the round
+// stops before reaching an unchecked candidate.  Thus all changes to the
+// clause database and all proof steps happen in the same order for any
+// number of threads.
+
+/*------------------------------------------------------------------------*/
+
+// Same as 'Internal::marked' but with thread local marks.
+
+static inline int subsume_marked (const signed char *marks, int lit) {
+  return marks[abs (lit)] * sign (lit);
+}
+
+// Read-only variant of 'try_to_subsume_clause' executed by worker threads.
+// In contrast to 'subsume_check' the literals of the checked clauses are
+// not moved, since other workers might read them concurrently.
+
+void Internal::subsume_check_candidate (SubsumeResult &result, Clause *c,
+                                        signed char *marks) {
+  result.subsuming = 0;
+  result.flipped = 0;
+  result.checks = result.checks2 = 0;
+  for (const auto &lit : *c)
+    marks[abs (lit)] = sign (lit);
+  for (const auto &lit : *c) {
+    if (!flags (lit).subsume)
+      continue;
+    for (int sign = -1; !result.flipped && sign <= 1; sign += 2) {
+      for (const auto &bin : bins (sign * lit)) {
+        const auto &other = bin.lit;
+        const signed char tmp = subsume_marked (marks, other);
+        if (!tmp)
+          continue;
+        if (tmp < 0) {
+          if (sign < 0)
+            continue;
+          result.binary[0] = lit;
+          result.binary[1] = other;
+          result.flipped = other;
+        } else {
+          result.binary[0] = sign * lit;
+          result.binary[1] = other;
+          result.flipped = (sign < 0) ? -lit : INT_MIN;
+        }
+        result.id = bin.id;
+        break;
+      }
+      if (result.flipped)
+        break;
+      for (const auto &e : occs (sign * lit)) {
+        assert (!e->garbage);
+        assert (e->size <= c->size);
+        result.checks++;
+        if (e->size == 2)
+          result.checks2++;
+        int flipped = 0;
+        bool failed = false;
+        for (const auto &other : *e) {
+          const signed char tmp = subsume_marked (marks, other);
+          if (tmp > 0)
+            continue;
+          if (!tmp || flipped) {
+            failed = true;
+            break;
+          }
+          flipped = other;
+        }
+        if (failed)
+          continue;
+        if (flipped && !opts.subsumestr)
+          continue;
+        result.subsuming = e;
+        result.flipped = flipped ? flipped : INT_MIN;
+        break;
+      }
+    }
+    if (result.flipped)
+      break;
+  }
+  for (const auto &lit : *c)
+    marks[abs (lit)] = 0;
+}
+
+// Check the candidates of the current batch until the checks exceed what
+// is left of 'check_limit'.
+
+void Internal::subsume_check_batch (Subsumer &subsumer,
+                                    int64_t check_limit) {
+  const vector<Clause *> &candidates = subsumer.candidates;
+  vector<SubsumeResult> &results = subsumer.results;
+  results.resize (candidates.size ());
+  subsumer.next = 0;
+
+  const size_t lits = 2u * (max_var + 1u);
+  if (subsumer.occs_before.size () < lits) {
+    subsumer.occs_before.resize (lits, 0);
+    subsumer.bins_before.resize (lits, 0);
+  }
+  for (const auto &u : subsumer.connected)
+    subsumer.occs_before[u] = subsumer.bins_before[u] = 0;
+  subsumer.connected.clear ();
+
+  const size_t threads = subsumer.pool.size ();
+  vector<vector<signed char>> &marks = subsumer.marks;
+  if (marks.size () < threads)
+    marks.resize (threads);
+  for (size_t i = 0; i < threads; i++)
+    if (marks[i].size () <= (size_t) max_var)
+      marks[i].resize (max_var + 1u, 0);
+
+  assert (stats.subchecks < check_limit);
+  const int64_t remaining = check_limit - stats.subchecks;
+  std::atomic<size_t> next (0);
+  std::atomic<int64_t> checks (0);
+  subsumer.pool.run ([this, &candidates, &results, &marks, remaining,
+                      &next, &checks] (size_t i) {
+    while (checks.load (std::memory_order_relaxed) < remaining) {
+      const size_t j = next++;
+      if (j >= candidates.size ())
+        break;
+      SubsumeResult &result = results[j];
+      subsume_check_candidate (result, candidates[j], marks[i].data ());
+      checks += result.checks;
+    }
+  });
+  subsumer.checked = min (next.load (), candidates.size ());
+
+  stats.subbatches++;
+  LOG ("checked %zu of batch of %zu subsumption candidates",
+       subsumer.checked, candidates.size ());
+}
+
+} // namespace CaDiCaL
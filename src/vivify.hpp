@@ -4,6 +4,7 @@
 namespace CaDiCaL {
 
 struct Clause;
+struct BackgroundVivifier; // Only used in 'vivifypar.cpp'.
 
 struct Vivifier {
   vector<Clause *> schedule, stack;
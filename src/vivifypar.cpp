@@ -0,0 +1,460 @@
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <thread>
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+// With 'vivifybackground' enabled a background thread tries to vivify
+// tier-two and tier-three learned clauses (glue larger than
+// 'reducetier1glue') concurrently to search.  It is started in 'reduce' on
+// a snapshot of the clause database, which contains all non-garbage
+// clauses simplified with respect to root-level units and is watched by
+// its own two-watched literal scheme.  Thus the worker never accesses the
+// solver and the solver does not have to wait for it.
+
+// For each candidate the worker assumes the negations of its literals one
+// after the other and propagates them over the other clauses of the
+// snapshot, as in 'vivify_clause'.  If this leads to a conflict or assigns
+// another literal of the candidate, or if some literal of the candidate
+// is implied to be false, the candidate is strengthened to the literals
+// assumed so far (plus the implied literal).  The worker records these
+// strengthened literals in the order they were tried.
+
+// At the next 'reduce' the worker is stopped and its results for clauses
+// which still exist are handed back to the search thread.  We can not
+// just replace a clause by its strengthened version, since the snapshot
+// might have contained clauses which have been removed in the meantime,
+// e.g., by variable elimination, and proofs (including LRAT chains) need
+// to be produced with respect to the current formula.  Thus the search
+// thread replays each result with 'vivify_clause', where assuming the
+// literals in the order of the result reaches the conflict (or the implied
+// literal) immediately without searching for a good literal order.  This
+// works on the regular watches (no need to reconnect them as in
+// 'vivify_round', since no literals are moved within clauses), and the
+// number of propagations is bounded relative to search propagations.
+
+// Taking a new snapshot copies the whole clause database.  Therefore the
+// worker continues on the same snapshot after handing back its results
+// until it has tried all its candidates.
+
+struct BackgroundVivifier {
+
+  struct Candidate {
+    int glue;
+    size_t ref;  // Position of its size in 'literals'.
+    uint64_t id; // Clause identifier in the solver.
+  };
+
+  vector<signed char> vals;       // Values indexed by variable.
+  vector<int> literals;           // Size followed by literals of clauses.
+  vector<vector<size_t>> watches; // Clause references indexed by 'vlit'.
+  vector<int64_t> noccs;          // Weighted occurrences by 'vlit'.
+  vector<Candidate> candidates;   // Clauses to vivify.
+
+  size_t next;                    // Next candidate to try.
+
+  vector<int> trail;     // Assigned literals (besides root-level units).
+  vector<int> sorted;    // Literals of the current candidate.
+  vector<int> decisions; // Assumed (negated) literals of the candidate.
+  size_t propagated;     // Next trail position to propagate.
+  size_t ignore;         // Reference of the current candidate.
+
+  struct Result {
+    uint64_t id;     // Identifier of the strengthened clause.
+    size_t literals; // Position of its literals in 'strengthened'.
+    unsigned size;   // Number of its remaining literals.
+  };
+
+  vector<Result> results;   // Of strengthened candidates.
+  vector<int> strengthened; // Literals of strengthened candidates.
+  int64_t checked;          // Number of tried candidates.
+
+  std::atomic<bool> stop;
+  std::thread thread;
+
+  BackgroundVivifier ()
+      : next (0), propagated (0), ignore (0), checked (0), stop (false) {}
+
+  static unsigned vlit (int lit) {
+    return (lit < 0) + 2u * (unsigned) abs (lit);
+  }
+
+  signed char val (int lit) const {
+    const signed char tmp = vals[abs (lit)];
+    return lit < 0 ? -tmp : tmp;
+  }
+
+  void assign (int lit) {
+    assert (!val (lit));
+    vals[abs (lit)] = sign (lit);
+    trail.push_back (lit);
+  }
+
+  bool propagate ();
+  void backtrack ();
+  bool vivify (const Candidate &);
+  void run ();
+};
+
+/*------------------------------------------------------------------------*/
+
+// Plain two-watched literal propagation on the snapshot, where the first
+// two literals of a clause are watched.  Returns 'false' on conflict.
+
+bool BackgroundVivifier::propagate () {
+  while (propagated < trail.size ()) {
+    const int lit = -trail[propagated++];
+    vector<size_t> &ws = watches[vlit (lit)];
+    const size_t end = ws.size ();
+    size_t i = 0, j = 0;
+    bool conflict = false;
+    while (!conflict && i != end) {
+      const size_t ref = ws[j++] = ws[i++];
+      if (ref == ignore)
+        continue;
+      const int size = literals[ref];
+      int *lits = &literals[ref + 1];
+      if (lits[0] == lit)
+        swap (lits[0], lits[1]);
+      assert (lits[1] == lit);
+      const signed char u = val (lits[0]);
+      if (u > 0)
+        continue;
+      int k = 2;
+      while (k < size && val (lits[k]) < 0)
+        k++;
+      if (k < size) {
+        lits[1] = lits[k];
+        lits[k] = lit;
+        watches[vlit (lits[1])].push_back (ref);
+        j--;
+      } else if (!u)
+        assign (lits[0]);
+      else
+        conflict = true;
+    }
+    while (i != end)
+      ws[j++] = ws[i++];
+    ws.resize (j);
+    if (conflict)
+      return false;
+  }
+  return true;
+}
+
+void BackgroundVivifier::backtrack () {
+  for (const auto &lit : trail)
+    vals[abs (lit)] = 0;
+  trail.clear ();
+  propagated = 0;
+}
+
+// Returns 'true' if the candidate can be strengthened, i.e., assuming the
+// negation of its literals in the order of more occurrences first leads
+// to a conflict, assigns one of its remaining literals to true or assigns
+// one of them to false.  Then the assumed literals (followed by the true
+// literal if any) are saved as result.
+
+bool BackgroundVivifier::vivify (const Candidate &candidate) {
+  const size_t ref = candidate.ref;
+  ignore = ref;
+  const int size = literals[ref];
+  const int *lits = &literals[ref + 1];
+  sorted.assign (lits, lits + size);
+  const vector<int64_t> &n = noccs;
+  sort (sorted.begin (), sorted.end (), [&n] (int a, int b) {
+    const int64_t s = n[vlit (a)], t = n[vlit (b)];
+    return s > t || (s == t && a < b);
+  });
+  decisions.clear ();
+  int implied = 0;
+  bool removed = false, failed = false;
+  for (const auto &lit : sorted) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) {
+      implied = lit;
+      break;
+    }
+    if (tmp < 0) {
+      removed = true;
+      continue;
+    }
+    decisions.push_back (lit);
+    assign (-lit);
+    if (!propagate ()) {
+      failed = true;
+      break;
+    }
+  }
+  backtrack ();
+  if (!implied && !failed && !removed)
+    return false;
+  const size_t new_size = decisions.size () + (implied != 0);
+  if (new_size >= (size_t) size)
+    return false;
+  Result result;
+  result.id = candidate.id;
+  result.literals = strengthened.size ();
+  result.size = new_size;
+  for (const auto &lit : decisions)
+    strengthened.push_back (lit);
+  if (implied)
+    strengthened.push_back (implied);
+  results.push_back (result);
+  return true;
+}
+
+// Continues with the candidates left from the previous run.
+
+void BackgroundVivifier::run () {
+  while (next < candidates.size ()) {
+    if (stop.load (std::memory_order_relaxed))
+      break;
+    checked++;
+    vivify (candidates[next++]);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Take a new snapshot unless there are candidates left in the current one
+// and start the worker thread.  Tier-two clauses (smaller glue) are tried
+// first.
+
+void Internal::start_background_vivification () {
+  assert (opts.vivifybackground);
+  assert (!unsat);
+  BackgroundVivifier *vivifier = background_vivifier;
+  if (!vivifier)
+    background_vivifier = vivifier = new BackgroundVivifier ();
+  assert (!vivifier->thread.joinable ());
+  assert (vivifier->results.empty ());
+
+  if (vivifier->next < vivifier->candidates.size ()) {
+    PHASE ("vivify-background", stats.reductions,
+           "continuing with %zu of %zu candidates",
+           vivifier->candidates.size () - vivifier->next,
+           vivifier->candidates.size ());
+    vivifier->stop = false;
+    vivifier->thread = std::thread (&BackgroundVivifier::run, vivifier);
+    return;
+  }
+
+  const size_t lits = 2u * (max_var + 1u);
+  vivifier->vals.assign (max_var + 1u, 0);
+  for (auto idx : vars)
+    vivifier->vals[idx] = (signed char) fixed (idx);
+  vivifier->literals.clear ();
+  vivifier->watches.resize (lits);
+  for (auto &ws : vivifier->watches)
+    ws.clear ();
+  vivifier->noccs.assign (lits, 0);
+  vivifier->candidates.clear ();
+  vivifier->next = 0;
+
+  vector<int> &literals = vivifier->literals;
+  for (const auto &c : clauses) {
+    if (c->garbage)
+      continue;
+    const size_t ref = literals.size ();
+    literals.push_back (0);
+    bool satisfied = false;
+    for (const auto &lit : *c) {
+      const int tmp = fixed (lit);
+      if (tmp > 0) {
+        satisfied = true;
+        break;
+      }
+      if (!tmp)
+        literals.push_back (lit);
+    }
+    const int size = literals.size () - ref - 1;
+    if (satisfied || size < 2) {
+      literals.resize (ref);
+      continue;
+    }
+    literals[ref] = size;
+    vivifier->watches[vlit (literals[ref + 1])].push_back (ref);
+    vivifier->watches[vlit (literals[ref + 2])].push_back (ref);
+    const int shift = 12 - size;
+    const int64_t score = shift < 1 ? 1 : (1l << shift);
+    for (int i = 1; i <= size; i++)
+      vivifier->noccs[vlit (literals[ref + i])] += score;
+    if (size > 2 && c->glue > opts.reducetier1glue &&
+        consider_to_vivify_clause (c, true)) {
+      BackgroundVivifier::Candidate candidate;
+      candidate.glue = c->glue;
+      candidate.ref = ref;
+      candidate.id = c->id;
+      vivifier->candidates.push_back (candidate);
+    }
+  }
+
+  stable_sort (vivifier->candidates.begin (), vivifier->candidates.end (),
+               [] (const BackgroundVivifier::Candidate &a,
+                   const BackgroundVivifier::Candidate &b) {
+                 return a.glue < b.glue;
+               });
+
+  PHASE ("vivify-background", stats.reductions,
+         "snapshot of %zu literals with %zu candidates", literals.size (),
+         vivifier->candidates.size ());
+
+  vivifier->stop = false;
+  vivifier->thread = std::thread (&BackgroundVivifier::run, vivifier);
+}
+
+// Stop and join the worker thread but keep its results.
+
+void Internal::stop_background_vivification () {
+  BackgroundVivifier *vivifier = background_vivifier;
+  if (!vivifier || !vivifier->thread.joinable ())
+    return;
+  vivifier->stop = true;
+  vivifier->thread.join ();
+  stats.vivifybgchecks += vivifier->checked;
+  vivifier->checked = 0;
+}
+
+void Internal::delete_background_vivifier () {
+  stop_background_vivification ();
+  delete background_vivifier;
+  background_vivifier = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Replay the results of the worker in the order they were found.  The
+// literals of the strengthened clause are tried first by giving them
+// decreasing occurrence counts, which 'vivify_clause' uses to sort the
+// literals of the candidate.
+
+void Internal::vivify_background_results () {
+  BackgroundVivifier *vivifier = background_vivifier;
+  vector<BackgroundVivifier::Result> &results = vivifier->results;
+  assert (!results.empty ());
+
+  vector<pair<uint64_t, size_t>> ids;
+  ids.reserve (results.size ());
+  for (size_t i = 0; i < results.size (); i++)
+    ids.push_back ({results[i].id, i});
+  sort (ids.begin (), ids.end ());
+  vector<Clause *> found (results.size (), 0);
+  size_t left = 0;
+  for (const auto &c : clauses) {
+    if (c->garbage || !c->redundant || c->size == 2)
+      continue;
+    const auto it = lower_bound (ids.begin (), ids.end (),
+                                 make_pair (c->id, (size_t) 0));
+    if (it == ids.end () || it->first != c->id)
+      continue;
+    found[it->second] = c;
+    left++;
+  }
+
+  PHASE ("vivify-background", stats.reductions,
+         "%zu of %zu strengthened candidates left", left, results.size ());
+  stats.vivifybgfound += results.size ();
+
+  int64_t limit = stats.propagations.search;
+  limit -= last.vivifybg.propagations;
+  limit *= 1e-3 * opts.vivifyreleff;
+  if (limit > opts.vivifymaxeff)
+    limit = opts.vivifymaxeff;
+  last.vivifybg.propagations = stats.propagations.search;
+
+  if (left && limit > 0) {
+    backtrack ();
+    START_SIMPLIFIER (vivify, VIVIFY);
+    stats.vivifications++;
+
+    const int64_t subsumed = stats.vivifysubs;
+    const int64_t strengthened = stats.vivifystrs;
+    const int64_t units = stats.vivifyunits;
+    int64_t replayed = 0;
+
+    init_noccs ();
+    Vivifier replayer (true);
+    limit += stats.propagations.vivify;
+    for (size_t i = 0; i < results.size (); i++) {
+      if (unsat || terminated_asynchronously ())
+        break;
+      if (stats.propagations.vivify >= limit)
+        break;
+      Clause *c = found[i];
+      if (!c || !consider_to_vivify_clause (c, true))
+        continue;
+      const BackgroundVivifier::Result &result = results[i];
+      const int *begin = &vivifier->strengthened[result.literals];
+      const int *end = begin + result.size;
+      for (const auto &lit : *c)
+        mark (lit);
+      bool contained = true;
+      for (const int *p = begin; contained && p != end; p++)
+        if (marked (*p) <= 0)
+          contained = false;
+      for (const auto &lit : *c)
+        unmark (lit);
+      if (!contained)
+        continue;
+      int64_t score = result.size;
+      for (const int *p = begin; p != end; p++)
+        noccs (*p) = score--;
+      vivify_clause (replayer, c);
+      for (const int *p = begin; p != end; p++)
+        noccs (*p) = 0;
+      replayed++;
+    }
+    if (level)
+      backtrack ();
+    reset_noccs ();
+
+    const int64_t changed = (stats.vivifysubs - subsumed) +
+                            (stats.vivifystrs - strengthened) +
+                            (stats.vivifyunits - units);
+    stats.subsumed += stats.vivifysubs - subsumed;
+    stats.strengthened += stats.vivifystrs - strengthened;
+    PHASE ("vivify-background", stats.reductions,
+           "replayed %" PRId64 " results which changed %" PRId64
+           " clauses",
+           replayed, changed);
+    STOP_SIMPLIFIER (vivify, VIVIFY);
+    if (changed)
+      report ('w', 1);
+  }
+
+  erase_vector (results);
+  erase_vector (vivifier->strengthened);
+}
+
+// Called at the end of 'reduce' to stop the worker, replay its results
+// and restart it.
+
+void Internal::vivify_in_background () {
+
+  stop_background_vivification ();
+
+  BackgroundVivifier *vivifier = background_vivifier;
+  if (vivifier && !vivifier->results.empty ()) {
+    if (unsat) {
+      erase_vector (vivifier->results);
+      erase_vector (vivifier->strengthened);
+    } else
+      vivify_background_results ();
+  }
+
+  if (unsat || external_prop || !opts.vivifybackground) {
+    if (vivifier)
+      delete_background_vivifier ();
+    return;
+  }
+
+  start_background_vivification ();
+}
+
+} // namespace CaDiCaL
@@ -1,7 +1,9 @@
 #ifndef _watch_hpp_INCLUDED
 #define _watch_hpp_INCLUDED
 
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <vector>
 
 namespace CaDiCaL {
@@ -9,11 +11,13 @@ namespace CaDiCaL {
 // Watch lists for CDCL search.  The blocking literal (see also comments
 // related to 'propagate') is a must and thus combining that with a 64 bit
 // pointer will give a 16 byte (8 byte aligned) structure anyhow, which
-// means the additional 4 bytes for the size come for free.  As alternative
-// one could use a 32-bit reference instead of the pointer which would
-// however limit the number of clauses to '2^32 - 1'.  One would also need
-// to use at least one more bit (either taken away from the variable space
-// or the clauses) to denote whether the watch is binary.
+// means the additional 4 bytes (used to inline ternary clauses) come for
+// free.  As alternative one could use a 32-bit reference instead of the
+// pointer which would however limit the number of clauses to '2^32 - 1'.
+// One would also need to use at least one more bit (either taken away from
+// the variable space or the clauses) to denote whether the watch is binary.
+// This is what the compile time option 'COMPACT' does (see 'ClauseSpace'
+// in 'arena.hpp').
 
 // in fashion of Intel Sat 10.4230/LIPIcs.SAT.2022.8 we try to
 // guarantee the following invariant:
@@ -26,18 +30,89 @@ namespace CaDiCaL {
 
 struct Clause;
 
+#ifndef COMPACT
+
+// Instead of the clause size we keep in these 4 bytes the other literals
+// of ternary clauses, which allows to propagate ternary clauses without
+// accessing the clause.  Since the blocking literal of a ternary clause is
+// always one of the two literals different from the watched literal,
+// storing their exclusive-or 'other' is enough to restore the third
+// literal, even after the blocking literal has been changed.  Binary
+// clause watches have 'other' zero (the two other literals of a ternary
+// clause differ) and large clauses 'INT_MIN'.  The (rare) ternary clause
+// where the exclusive-or happens to be 'INT_MIN' is treated as large.
+
 struct Watch {
 
   Clause *clause;
   int blit;
-  int size;
+  int other;
+
+  Watch (int lit, int b, Clause *c) : clause (c), blit (b) {
+    update (lit, c);
+  }
+  Watch () {}
+
+  bool binary () const { return !other; }
+  bool ternary () const { return other && other != INT_MIN; }
+  int third () const {
+    assert (ternary ());
+    return other ^ blit;
+  }
+
+  // Recompute 'other' for the watch of 'lit' after 'c' changed.
+
+  void update (int lit, const Clause *c) {
+    if (c->size == 2)
+      other = 0;
+    else if (c->size == 3) {
+      const int *lits = c->literals;
+      other = lits[0] ^ lits[1] ^ lits[2] ^ lit;
+    } else
+      other = INT_MIN;
+  }
+};
+
+#else
+
+// The 32-bit clause reference of a compact watch with the least significant
+// bit denoting binary clauses.  It can be used like a clause pointer.
+
+class ClauseRef {
+
+  unsigned bits;
+
+public:
+  ClauseRef (Clause *c)
+      : bits (ClauseSpace::reference (c) << 1 | (c->size == 2)) {}
+  ClauseRef () {}
+
+  operator Clause * () const {
+    return (Clause *) ClauseSpace::dereference (bits >> 1);
+  }
+  Clause *operator->() const { return *this; }
+  Clause &operator* () const { return *(Clause *) *this; }
+
+  bool binary () const { return bits & 1; }
+  void set_binary (bool binary) { bits = (bits & ~1u) | binary; }
+};
+
+struct Watch {
+
+  ClauseRef clause;
+  int blit;
 
-  Watch (int b, Clause *c) : clause (c), blit (b), size (c->size) {}
+  Watch (int, int b, Clause *c) : clause (c), blit (b) {}
   Watch () {}
 
-  bool binary () const { return size == 2; }
+  bool binary () const { return clause.binary (); }
+  bool ternary () const { return false; }
+  int third () const { return 0; }
+  void update (int, const Clause *c) { clause.set_binary (c->size == 2); }
 };
 
+#endif
+
 typedef vector<Watch> Watches; // of one literal
 
 typedef Watches::iterator watch_iterator;
@@ -55,16 +130,55 @@ inline void remove_watch (Watches &ws, Clause *clause) {
   ws.resize (i - ws.begin ());
 }
 
-// search for the clause and updates the size marked in the watch lists
-inline void update_watch_size (Watches &ws, int blit, Clause *conflict) {
-  bool found = false;
-  const int size = conflict->size;
-  for (Watch &w : ws) {
-    if (w.clause == conflict)
-      w.size = size, w.blit = blit, found = true;
-    assert (w.clause->garbage || w.size == 2 || w.clause->size != 2);
+// Binary watches are kept in front of the watches of larger clauses, such
+// that 'propagate' can visit them first in a separate tight loop.  This is
+// what connecting and flushing watches produce anyhow.  Binary clauses
+// added later are watched through 'watch_literal', which calls this
+// function to move the new binary watch (the last one) in front of the
+// first larger clause watch.  We swap these two watches instead of
+// shifting all larger clause watches, since probing adds hyper binary
+// resolvents while traversing watches by index.  The swap keeps the
+// positions of all other watches and the swapped large clause watch is
+// just visited once more.  Watches of clauses shrunken to binary clauses in
+// place are moved by 'update_watch_size' below.  Thus 'propagate' can
+// assert that no binary watch follows a larger clause watch.
+
+inline void keep_binary_watches_first (Watches &ws) {
+  assert (!ws.empty ());
+  assert (ws.back ().binary ());
+  const auto last = ws.end () - 1;
+  if (last == ws.begin () || last[-1].binary ())
+    return;
+  auto i = ws.begin ();
+  while (i->binary ())
+    i++;
+  assert (i < last);
+  std::swap (*i, *last);
+}
+
+// Search for the clause and update the size marked in the watch list of
+// the watched literal 'lit' (including the inlined ternary literals).  If
+// the clause became binary its watch is moved in front of the larger
+// clause watches, which keep their relative order.
+
+inline void update_watch_size (Watches &ws, int lit, int blit,
+                               Clause *conflict) {
+  const auto begin = ws.begin (), end = ws.end ();
+  auto i = begin;
+  while (i != end && (Clause *) i->clause != conflict)
+    i++;
+  assert (i != end);
+  i->update (lit, conflict), i->blit = blit;
+  if (i->binary ()) {
+    auto k = i;
+    while (k != begin && !k[-1].binary ())
+      k--;
+    std::rotate (k, i, i + 1);
   }
-  assert (found), (void) found;
+#ifndef NDEBUG
+  for (const auto &w : ws)
+    assert (w.clause->garbage || w.binary () || w.clause->size != 2);
+#endif
 }
 
 } // namespace CaDiCaL
@@ -0,0 +1,166 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+static int n = 6;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n + 1) + p;
+}
+
+// Pigeon hole formula for 'n+1' pigeons in 'n' holes (or 'n' pigeons if
+// 'sat' is true).
+
+static void formula (Solver &solver, bool sat) {
+  const int m = sat ? n : n + 1;
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < m; p1++)
+      for (int p2 = p1 + 1; p2 < m; p2++)
+        solver.add (-ph (p1, h)), solver.add (-ph (p2, h)), solver.add (0);
+  for (int p = 0; p < m; p++) {
+    for (int h = 0; h < n; h++)
+      solver.add (ph (p, h));
+    solver.add (0);
+  }
+}
+
+static Solver::CubesWithStatus cubes (bool sat, int threads, int depth,
+                                      int target = 0, int max = 0) {
+  Solver solver;
+  solver.set ("quiet", 1);
+  solver.set ("cubetarget", target);
+  solver.set ("cubemax", max);
+  solver.set ("cubethreads", threads);
+  solver.set ("cubethreadsdepth", 2);
+  formula (solver, sat);
+  return solver.generate_cubes (depth);
+}
+
+// Streams cubes and stops after 'limit' cubes.
+
+struct Streamer : CubeIterator {
+  vector<vector<int>> cubes;
+  size_t limit;
+  Streamer (size_t l) : limit (l) {}
+  bool cube (const vector<int> &c) {
+    cubes.push_back (c);
+    return cubes.size () < limit;
+  }
+};
+
+static vector<vector<int>> stream (bool sat, int threads, size_t limit) {
+  Solver solver;
+  solver.set ("quiet", 1);
+  solver.set ("cubethreads", threads);
+  solver.set ("cubethreadsdepth", 2);
+  formula (solver, sat);
+  Streamer streamer (limit);
+  int res = solver.generate_cubes (5, streamer);
+  assert (!res);
+  return streamer.cubes;
+}
+
+static int solve (bool sat, const vector<int> &cube) {
+  Solver solver;
+  formula (solver, sat);
+  for (const auto &lit : cube) {
+    assert (lit), assert (abs (lit) <= solver.vars ());
+    solver.assume (lit);
+  }
+  return solver.solve ();
+}
+
+// Collects learned clauses.
+
+struct Learned : ClauseIterator {
+  vector<vector<int>> clauses;
+  bool clause (const vector<int> &c) {
+    clauses.push_back (c);
+    return true;
+  }
+};
+
+// Learned clauses exported after generating cubes have to be implied.
+
+static void learned (bool sat) {
+  Solver solver;
+  solver.set ("quiet", 1);
+  formula (solver, sat);
+  solver.generate_cubes (5);
+  Learned learned;
+  bool res = solver.traverse_learned_clauses (learned, 3);
+  assert (res);
+  for (const auto &clause : learned.clauses) {
+    assert (clause.size () <= 3);
+    vector<int> cube;
+    for (const auto &lit : clause)
+      cube.push_back (-lit);
+    assert (solve (sat, cube) == 20);
+  }
+}
+
+// Sharding has to keep all cubes.
+
+static void shards (bool sat) {
+  Solver solver;
+  solver.set ("quiet", 1);
+  formula (solver, sat);
+  auto cubes = solver.generate_cubes (5);
+  auto shards = solver.shard_cubes (cubes.cubes, 3);
+  assert (shards.size () == 3);
+  vector<vector<int>> all;
+  for (const auto &shard : shards)
+    all.insert (all.end (), shard.begin (), shard.end ());
+  sort (all.begin (), all.end ());
+  sort (cubes.cubes.begin (), cubes.cubes.end ());
+  assert (all == cubes.cubes);
+}
+
+int main () {
+  for (int sat = 0; sat < 2; sat++) {
+    auto one = cubes (sat, 1, 5);
+    auto three = cubes (sat, 3, 5);
+    assert (one.status == three.status);
+    assert (one.cubes == three.cubes);
+    int satisfied = 0;
+    for (const auto &cube : three.cubes) {
+      const int res = solve (sat, cube);
+      assert (res == 10 || res == 20);
+      satisfied += (res == 10);
+    }
+    assert (sat ? satisfied > 0 : !satisfied);
+    for (int threads = 0; threads < 3; threads += 2) {
+      auto bounded = cubes (sat, threads, 12, 0, 5);
+      assert (!bounded.status);
+      assert (bounded.cubes.size () <= 5);
+    }
+    auto adaptive = cubes (sat, 0, 12, 16);
+    assert (!adaptive.status);
+    satisfied = 0;
+    for (const auto &cube : adaptive.cubes)
+      satisfied += (solve (sat, cube) == 10);
+    assert (sat ? satisfied > 0 : !satisfied);
+    for (int threads = 0; threads < 3; threads += 2) {
+      auto all = stream (sat, threads, -1);
+      assert (all == (threads ? three : cubes (sat, 0, 5)).cubes);
+      auto some = stream (sat, threads, 3);
+      assert (some.size () == 3);
+      assert (equal (some.begin (), some.end (), all.begin ()));
+    }
+    learned (sat);
+    shards (sat);
+  }
+  return 0;
+}
@@ -111,6 +111,8 @@ run terminate
 run learn
 run cfreeze
 run traverse
+run cubes
+run share
 run cipasir
 run incproof
 
@@ -0,0 +1,90 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <climits>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+static int n = 7;
+
+static int ph (int p, int h) {
+  assert (0 <= p), assert (p < n + 1);
+  assert (0 <= h), assert (h < n);
+  return 1 + h * (n + 1) + p;
+}
+
+// Pigeon hole formula for 'n+1' pigeons in 'n' holes (or 'n' pigeons if
+// 'sat' is true).
+
+static void formula (Solver &solver, bool sat) {
+  const int m = sat ? n : n + 1;
+  for (int h = 0; h < n; h++)
+    for (int p1 = 0; p1 < m; p1++)
+      for (int p2 = p1 + 1; p2 < m; p2++)
+        solver.add (-ph (p1, h)), solver.add (-ph (p2, h)), solver.add (0);
+  for (int p = 0; p < m; p++) {
+    for (int h = 0; h < n; h++)
+      solver.add (ph (p, h));
+    solver.add (0);
+  }
+}
+
+// Clauses have to wrap around and are dropped if the buffer is full.
+
+static void buffer () {
+  ClauseBuffer buffer (8);
+  vector<int> clause;
+  int glue;
+  assert (buffer.empty ());
+  assert (!buffer.pop (clause, glue));
+  const int ternary[] = {1, -2, 3};
+  const int binary[] = {-4, 5};
+  assert (buffer.push (ternary, 3, 2));
+  assert (!buffer.push (binary, 2, 1));
+  assert (buffer.dropped () == 1);
+  assert (buffer.pop (clause, glue));
+  assert (clause == vector<int> (ternary, ternary + 3));
+  assert (glue == 2);
+  assert (buffer.empty ());
+  assert (buffer.push (binary, 2, 1));
+  assert (buffer.push (ternary, 0, 0));
+  assert (buffer.pop (clause, glue));
+  assert (clause == vector<int> (binary, binary + 2));
+  assert (glue == 1);
+  assert (buffer.pop (clause, glue));
+  assert (clause.empty ());
+  assert (buffer.empty ());
+  assert (buffer.pushed () == 3 && buffer.popped () == 3);
+}
+
+// Clauses exported by one solver are implied and thus can be imported by
+// a second solver on the same formula without changing the result.
+
+static void share (bool sat) {
+  ClauseBuffer buffer;
+  Solver producer, consumer;
+  producer.set ("quiet", 1), consumer.set ("quiet", 1);
+  consumer.set ("restartint", 1);
+  formula (producer, sat), formula (consumer, sat);
+  producer.connect_export_buffer (&buffer, INT_MAX, INT_MAX);
+  const int res = producer.solve ();
+  assert (res == (sat ? 10 : 20));
+  producer.disconnect_export_buffers ();
+  assert (buffer.pushed () > 0);
+  consumer.connect_import_buffer (&buffer);
+  assert (consumer.solve () == res);
+  consumer.disconnect_import_buffers ();
+}
+
+int main () {
+  buffer ();
+  for (int sat = 0; sat < 2; sat++)
+    share (sat);
+  return 0;
+}
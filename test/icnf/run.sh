@@ -54,7 +54,7 @@ run () {
   log=$prefix-$1.log
   err=$prefix-$1.err
   opts="$icnf --check"
-  opts="$icnf"
+  opts="$icnf $3"
   cecho "$solver \\"
   cecho "$opts"
   cecho -n "# $2 ..."
@@ -76,6 +76,17 @@ run unit1 20
 run unit2 10
 run two1 20
 run two2 10
+run prime49 10 "-c 1 --resplit=1"
+
+for threads in 2 3
+do
+  run false 20 --threads=$threads
+  run unit1 20 --threads=$threads
+  run unit2 10 --threads=$threads
+  run two1 20 --threads=$threads
+  run two2 10 --threads=$threads
+  run prime49 10 "-c 1 --resplit=1 --threads=$threads"
+done
 
 #--------------------------------------------------------------------------#
 
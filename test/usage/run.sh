@@ -118,6 +118,53 @@ do
   run 20 $option ../test/cnf/add16.cnf
 done
 
+for option in "--cube-and-conquer=0" "--cube-and-conquer=3 --threads=2" \
+  "--cube-and-conquer=3 --threads=2 --share=0" \
+  "--cube-and-conquer=3 --threads=2 --share=8"
+do
+  run 10 $option ../test/cnf/prime2209.cnf
+  run 20 $option ../test/cnf/add16.cnf
+done
+
+for option in "--cube-and-conquer=2 -c 10 --resplit=1" \
+  "--cube-and-conquer=2 -c 10 --resplit=1 --threads=2"
+do
+  run 10 $option ../test/cnf/prime2209.cnf
+  run 20 $option ../test/cnf/add16.cnf
+done
+
+run 1 --cube-and-conquer=-1 ../test/cnf/add16.cnf
+run 1 --threads=0 ../test/cnf/add16.cnf
+run 1 --share=-1 ../test/cnf/add16.cnf
+run 1 --cube-and-conquer=2 --resplit=0 ../test/cnf/add16.cnf
+run 1 --resplit=1 ../test/cnf/add16.cnf
+
+for option in "--portfolio=1" "--portfolio=4" "--portfolio=2 --unsat"
+do
+  run 10 $option ../test/cnf/prime2209.cnf
+  run 20 $option ../test/cnf/add16.cnf
+done
+
+run 1 --portfolio=0 ../test/cnf/add16.cnf
+run 1 --portfolio=2 --cube-and-conquer=2 ../test/cnf/add16.cnf
+
+run 0 --write-cubes=$CADICALBUILD/test-usage.cubes ../test/cnf/add16.cnf
+run 0 --write-inccnf=$CADICALBUILD/test-usage.icnf --cube-depth=3 \
+  ../test/cnf/prime2209.cnf
+run 10 $CADICALBUILD/test-usage.icnf
+run 0 --write-inccnf=$CADICALBUILD/test-usage.icnf --shards=2 \
+  ../test/cnf/add16.cnf
+run 20 $CADICALBUILD/test-usage-1.icnf
+run 0 --write-inccnf=$CADICALBUILD/test-usage.icnf --cube-depth=4 \
+  --cubegates=0 ../test/cnf/add16.cnf
+run 20 $CADICALBUILD/test-usage.icnf
+run 1 --cube-depth=3 ../test/cnf/add16.cnf
+run 1 --shards=2 ../test/cnf/add16.cnf
+run 1 --write-cubes=$CADICALBUILD/test-usage.cubes --cube-depth=-1 \
+  ../test/cnf/add16.cnf
+run 1 --write-cubes=$CADICALBUILD/test-usage.cubes --cube-and-conquer=3 \
+  ../test/cnf/add16.cnf
+
 # run 0 -t
 # run 0 -O
 # run 0 -c 0